@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <cstddef>
 
 using namespace Bink;
 
@@ -15,37 +16,39 @@ void Frame::Plane::setSize(uint32_t iw, uint32_t ih) {
   stride = w16;
   }
 
-void Frame::Plane::getPixels8x8(uint32_t rx, uint32_t ry, uint8_t* out) const {
-  const uint8_t* d = dat.data();
+void Frame::Plane::getPixels8x8(int rx, int ry, uint8_t* out) const {
+  const uint8_t* d = dat.data() + (ptrdiff_t(ry)*stride + rx);
+  for(uint32_t y=0; y<8; ++y)
+    std::memcpy(out+y*8, d + y*stride, 8);
+  }
 
-  for(uint32_t y=0; y<8; ++y) {
-    for(uint32_t x=0; x<8; ++x) {
-      out[x+y*8] = d[(x+rx) + (y+ry)*stride];
-      }
-    }
+bool Frame::Plane::hasPixels8x8(int rx, int ry) const {
+  // linear range check, same as ffmpeg: rows may wrap across the stride,
+  // as long as the whole 8x8 read stays inside the buffer
+  const ptrdiff_t off = ptrdiff_t(ry)*stride + rx;
+  const ptrdiff_t end = ptrdiff_t(dat.size()) - ptrdiff_t(7*stride+8);
+  return 0<=off && off<=end;
   }
 
 void Frame::Plane::getBlock8x8(uint32_t bx, uint32_t by, uint8_t* out) const {
-  getPixels8x8(bx*8,by*8,out);
+  getPixels8x8(int(bx*8),int(by*8),out);
   }
 
 void Frame::Plane::putBlock8x8(uint32_t bx, uint32_t by, const uint8_t* in) {
-  uint8_t* d = dat.data();
-
-  for(uint32_t y=0; y<8; ++y) {
-    for(uint32_t x=0; x<8; ++x) {
-      d[(x+bx*8) + (y+by*8)*stride] = in[x+y*8];
-      }
-    }
+  uint8_t* d = dat.data() + (bx*8 + by*8*stride);
+  for(uint32_t y=0; y<8; ++y)
+    std::memcpy(d+y*stride, in+y*8, 8);
   }
 
 void Frame::Plane::putScaledBlock(uint32_t bx, uint32_t by, const uint8_t* in) {
-  uint8_t* d = dat.data();
-  for(uint32_t y=0; y<16; ++y) {
-    uint32_t y2 = y/2;
-    for(uint32_t x=0; x<16; ++x) {
-      d[(x+bx*8) + (y+by*8)*stride] = in[(x/2)+y2*8];
-      }
+  uint8_t* d = dat.data() + (bx*8 + by*8*stride);
+  for(uint32_t y=0; y<8; ++y) {
+    // widen source row once, then store it to both destination rows
+    uint8_t row[16];
+    for(uint32_t x=0; x<16; ++x)
+      row[x] = in[x/2 + y*8];
+    std::memcpy(d + (y*2  )*stride, row, 16);
+    std::memcpy(d + (y*2+1)*stride, row, 16);
     }
   }
 
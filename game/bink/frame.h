@@ -16,7 +16,8 @@ class Frame final {
 
     class Plane final {
       public:
-        void getPixels8x8  (uint32_t rx, uint32_t ry, uint8_t* out) const;
+        void getPixels8x8  (int rx, int ry, uint8_t* out) const;
+        bool hasPixels8x8  (int rx, int ry) const;
 
         void getBlock8x8   (uint32_t x, uint32_t y, uint8_t* out) const;
         void putBlock8x8   (uint32_t x, uint32_t y, const uint8_t* in);
@@ -25,6 +26,7 @@ class Frame final {
 
         uint8_t        at(uint32_t x, uint32_t y) const;
         const uint8_t* data() const { return dat.data(); }
+        const uint8_t* row(uint32_t y) const { return dat.data() + y*stride; }
 
       private:
         void setSize(uint32_t w, uint32_t h);
@@ -6,6 +6,7 @@
 #endif
 
 #include <stdexcept>
+#include <exception>
 #include <iostream>
 #include <cmath>
 #include <cstring>
@@ -923,6 +924,13 @@ Video::Video(Input* file) : fin(file) {
   }
 
 Video::~Video() {
+  {
+  std::lock_guard<std::mutex> guard(chromaSync);
+  chromaStop = true;
+  }
+  chromaCv.notify_all();
+  if(chromaThread.joinable())
+    chromaThread.join();
   }
 
 const Frame& Video::nextFrame() {
@@ -1072,10 +1080,11 @@ void Video::decodeInit() {
   const int bw     = (width  + 7) >> 3;
   const int bh     = (height + 7) >> 3;
   const int blocks = bw * bh;
-  for(auto& b:bundle) {
-    b.data.resize(blocks * 64);
-    b.data_end = b.data.data() + blocks * 64;
-    }
+  for(auto& ctx:planeCtx)
+    for(auto& b:ctx.bundle) {
+      b.data.resize(blocks * 64);
+      b.data_end = b.data.data() + blocks * 64;
+      }
 
 /*
   if(revision == 'b') {
@@ -1122,7 +1131,8 @@ uint8_t Video::getHuff(BitStream& gb, const Tree& tree) {
   return tree.syms[vlc];
   }
 
-void Video::initLengths(int width, int bw) {
+void Video::initLengths(PlaneCtx& ctx, int width, int bw) {
+  auto& bundle = ctx.bundle;
   width = ((width+7)/8)*8;
 
   bundle[BINK_SRC_BLOCK_TYPES].len     = av_log2((width >> 3) + 511) + 1;
@@ -1138,35 +1148,107 @@ void Video::initLengths(int width, int bw) {
   }
 
 void Video::parseFrame(const std::vector<uint8_t>& data) {
-  const bool   swap_planes = (revision >= 'h');
-  const size_t bits_count  = data.size()<<3;
+  const size_t bits_count = data.size()<<3;
 
   BitStream gb(data.data(),bits_count);
 
+  if(revision<='b') {
+    //decodePlaneB(gb, planeId, frameCounter==0, plane!=0);
+    throw std::runtime_error("not implemented");
+    }
+
   if((flags&BINK_FLAG_ALPHA) == BINK_FLAG_ALPHA) {
     if(revision >= 'i')
       gb.skip(32);
-    decodePlane(gb,3,false);
+    decodePlane(gb,planeCtx[0],3,false);
     }
-  if(revision >= 'i')
-    gb.skip(32);
 
-  for(int plane=0; plane<3; plane++) {
-    const int planeId = (!plane || !swap_planes) ? plane : (plane ^ 3);
+  size_t chromaAt = 0;
+  if(revision >= 'i') {
+    // byte offset of chroma planes
+    chromaAt  = gb.getBits(16);
+    chromaAt |= size_t(gb.getBits(16)) << 16;
+    chromaAt *= 8;
+    }
 
-    if(revision>'b') {
-      decodePlane(gb, planeId, plane!=0);
-      } else {
-      //decodePlaneB(gb, planeId, frameCounter==0, plane!=0);
-      throw std::runtime_error("not implemented");
+  if(chromaOffset!=CHROMA_OFFSET_VALID || chromaAt<=gb.position() || chromaAt>=bits_count) {
+    decodePlane(gb,planeCtx[0],0,false);
+    if(chromaOffset==CHROMA_OFFSET_UNKNOWN && revision>='i')
+      chromaOffset = (gb.position()==chromaAt) ? CHROMA_OFFSET_VALID : CHROMA_OFFSET_INVALID;
+    decodeChroma(gb,planeCtx[1],bits_count);
+    return;
+    }
+
+  // chroma planes are located independently - decode them while luma is in progress
+  BitStream gbc(data.data(),bits_count);
+  gbc.skip(chromaAt);
+  startChroma(gbc,bits_count);
+  try {
+    decodePlane(gb,planeCtx[0],0,false);
+    }
+  catch(...) {
+    waitChroma();
+    throw;
+    }
+  waitChroma();
+
+  if(gb.position()!=chromaAt) {
+    // offset doesn't match actual bitstream layout: redo sequentially and don't trust it anymore
+    chromaOffset = CHROMA_OFFSET_INVALID;
+    decodeChroma(gb,planeCtx[1],bits_count);
+    return;
+    }
+  if(chromaErr!=nullptr)
+    std::rethrow_exception(chromaErr);
+  }
+
+void Video::chromaThreadFunc() {
+  std::unique_lock<std::mutex> guard(chromaSync);
+  while(true) {
+    chromaCv.wait(guard,[this](){ return chromaStop || chromaGb!=nullptr; });
+    if(chromaStop)
+      return;
+    BitStream& gb = *chromaGb;
+    guard.unlock();
+    try {
+      decodeChroma(gb,planeCtx[1],chromaBits);
+      }
+    catch(...) {
+      chromaErr = std::current_exception();
       }
+    guard.lock();
+    chromaGb = nullptr;
+    chromaCv.notify_all();
+    }
+  }
 
-    if(gb.position()>=bits_count)
+void Video::startChroma(BitStream& gb, size_t bitsCount) {
+  {
+  std::lock_guard<std::mutex> guard(chromaSync);
+  chromaGb   = &gb;
+  chromaBits = bitsCount;
+  chromaErr  = nullptr;
+  }
+  if(!chromaThread.joinable())
+    chromaThread = std::thread(&Video::chromaThreadFunc,this);
+  chromaCv.notify_all();
+  }
+
+void Video::waitChroma() {
+  std::unique_lock<std::mutex> guard(chromaSync);
+  chromaCv.wait(guard,[this](){ return chromaGb==nullptr; });
+  }
+
+void Video::decodeChroma(BitStream& gb, PlaneCtx& ctx, size_t bitsCount) {
+  for(int plane=1; plane<3; plane++) {
+    if(gb.position()>=bitsCount)
       break;
+    const int planeId = !swap_planes ? plane : (plane ^ 3);
+    decodePlane(gb, ctx, planeId, true);
     }
   }
 
-void Video::decodePlane(BitStream& gb, int planeId, bool chroma) {
+void Video::decodePlane(BitStream& gb, PlaneCtx& ctx, int planeId, bool chroma) {
   const int bw     = chroma ? (this->width  + 15) >> 4 : (this->width  + 7) >> 3;
   const int bh     = chroma ? (this->height + 15) >> 4 : (this->height + 7) >> 3;
   const int width  = this->width  >> (chroma ? 1 : 0);
@@ -1182,15 +1264,16 @@ void Video::decodePlane(BitStream& gb, int planeId, bool chroma) {
     return;
     }
 
-  initLengths(std::max(width,8),bw);
+  auto& bundle = ctx.bundle;
+  initLengths(ctx,std::max(width,8),bw);
   for(int i=0; i<BINK_NB_SRC; i++)
-    readBundle(gb,i);
+    readBundle(gb,ctx,i);
 
   uint8_t dst[8*8] = {};
   for(int by = 0; by < bh; by++) {
     readBlockTypes  (gb,bundle[BINK_SRC_BLOCK_TYPES]);
     readBlockTypes  (gb,bundle[BINK_SRC_SUB_BLOCK_TYPES]);
-    readColors      (gb,bundle[BINK_SRC_COLORS]);
+    readColors      (gb,ctx);
     readPatterns    (gb,bundle[BINK_SRC_PATTERN]);
     readMotionValues(gb,bundle[BINK_SRC_X_OFF]);
     readMotionValues(gb,bundle[BINK_SRC_Y_OFF]);
@@ -1199,7 +1282,7 @@ void Video::decodePlane(BitStream& gb, int planeId, bool chroma) {
     readRuns        (gb,bundle[BINK_SRC_RUN]);
 
     for(int bx=0; bx<bw; ++bx) {
-      BlockTypes blk = BlockTypes(getValue(BINK_SRC_BLOCK_TYPES));
+      BlockTypes blk = BlockTypes(getValue(ctx,BINK_SRC_BLOCK_TYPES));
       // 16x16 block type on odd line means part of the already decoded block, so skip it
       if((by & 1) && blk == SCALED_BLOCK) {
         bx++;
@@ -1208,7 +1291,7 @@ void Video::decodePlane(BitStream& gb, int planeId, bool chroma) {
 
       bool isScaled = false;
       if(blk==SCALED_BLOCK){
-        blk = BlockTypes(getValue(BINK_SRC_SUB_BLOCK_TYPES));
+        blk = BlockTypes(getValue(ctx,BINK_SRC_SUB_BLOCK_TYPES));
         isScaled = true;
         }
 
@@ -1219,15 +1302,15 @@ void Video::decodePlane(BitStream& gb, int planeId, bool chroma) {
           last.getBlock8x8(bx,by,dst);
           break;
         case FILL_BLOCK:    {
-          const uint8_t v = uint8_t(getValue(BINK_SRC_COLORS));
+          const uint8_t v = uint8_t(getValue(ctx,BINK_SRC_COLORS));
           std::memset(dst,v,sizeof(dst));
           break;
           }
         case RESIDUE_BLOCK: {
           uint8_t prev[8*8] = {};
-          const int xoff = getValue(BINK_SRC_X_OFF);
-          const int yoff = getValue(BINK_SRC_Y_OFF);
-          last.getPixels8x8(bx*8+xoff, by*8+yoff, prev);
+          const int xoff = getValue(ctx,BINK_SRC_X_OFF);
+          const int yoff = getValue(ctx,BINK_SRC_Y_OFF);
+          getMotionBlock(last, bx*8+xoff, by*8+yoff, prev);
 
           int16_t block[64] = {};
           int v = gb.getBits(7);
@@ -1238,7 +1321,7 @@ void Video::decodePlane(BitStream& gb, int planeId, bool chroma) {
           }
         case INTRA_BLOCK:   {
           int32_t dctblock[64] = {};
-          dctblock[0] = getValue(BINK_SRC_INTRA_DC);
+          dctblock[0] = getValue(ctx,BINK_SRC_INTRA_DC);
           int coef_count=0, coef_idx[64]={};
           int quant_idx = readDctCoeffs(gb, dctblock, bink_scan, coef_count, coef_idx, -1);
           unquantizeDctCoeffs(dctblock, bink_intra_quant[quant_idx], coef_count, coef_idx, bink_scan);
@@ -1251,12 +1334,12 @@ void Video::decodePlane(BitStream& gb, int planeId, bool chroma) {
           }
         case INTER_BLOCK:   {
           uint8_t prev[8*8] = {};
-          const int xoff = getValue(BINK_SRC_X_OFF);
-          const int yoff = getValue(BINK_SRC_Y_OFF);
-          last.getPixels8x8(bx*8+xoff, by*8+yoff, prev);
+          const int xoff = getValue(ctx,BINK_SRC_X_OFF);
+          const int yoff = getValue(ctx,BINK_SRC_Y_OFF);
+          getMotionBlock(last, bx*8+xoff, by*8+yoff, prev);
 
           int32_t dctblock[64] = {};
-          dctblock[0] = getValue(BINK_SRC_INTER_DC);
+          dctblock[0] = getValue(ctx,BINK_SRC_INTER_DC);
           int coef_count=0, coef_idx[64]={};
           int quant_idx = readDctCoeffs(gb, dctblock, bink_scan, coef_count, coef_idx, -1);
           unquantizeDctCoeffs(dctblock, bink_inter_quant[quant_idx], coef_count, coef_idx, bink_scan);
@@ -1274,37 +1357,37 @@ void Video::decodePlane(BitStream& gb, int planeId, bool chroma) {
           const uint8_t* scan = bink_patterns[gb.getBits(4)];
           int i = 0;
           do {
-            const int run = getValue(BINK_SRC_RUN) + 1;
+            const int run = getValue(ctx,BINK_SRC_RUN) + 1;
             i += run;
             if(i > 64)
               throw VideoDecodingException("Run went out of bounds");
             if(gb.getBit()) {
-              int v = getValue(BINK_SRC_COLORS);
+              int v = getValue(ctx,BINK_SRC_COLORS);
               for(int j = 0; j < run; j++)
                 dst[*scan++] = uint8_t(v);
               } else {
               for(int j = 0; j < run; j++)
-                dst[*scan++] = uint8_t(getValue(BINK_SRC_COLORS));
+                dst[*scan++] = uint8_t(getValue(ctx,BINK_SRC_COLORS));
               }
             } while (i < 63);
           if(i == 63)
-            dst[*scan++] = uint8_t(getValue(BINK_SRC_COLORS));
+            dst[*scan++] = uint8_t(getValue(ctx,BINK_SRC_COLORS));
           break;
           }
         case MOTION_BLOCK:  {
           if(isScaled)
             throw VideoDecodingException("unsupported type of superblock");
-          const int xoff = getValue(BINK_SRC_X_OFF);
-          const int yoff = getValue(BINK_SRC_Y_OFF);
-          last.getPixels8x8(bx*8+xoff, by*8+yoff, dst);
+          const int xoff = getValue(ctx,BINK_SRC_X_OFF);
+          const int yoff = getValue(ctx,BINK_SRC_Y_OFF);
+          getMotionBlock(last, bx*8+xoff, by*8+yoff, dst);
           break;
           }
         case PATTERN_BLOCK: {
           uint8_t col[2] = {};
           for(int i=0; i<2; i++)
-            col[i] = uint8_t(getValue(BINK_SRC_COLORS));
+            col[i] = uint8_t(getValue(ctx,BINK_SRC_COLORS));
           for(int i=0; i<8; i++) {
-            int v = getValue(BINK_SRC_PATTERN);
+            int v = getValue(ctx,BINK_SRC_PATTERN);
             for(int j=0; j<8; j++, v >>= 1)
               dst[i*8+j] = col[v & 1];
             }
@@ -1332,11 +1415,12 @@ void Video::decodePlane(BitStream& gb, int planeId, bool chroma) {
   gb.align32();
   }
 
-void Video::readBundle(BitStream& gb, int bundle_num) {
+void Video::readBundle(BitStream& gb, PlaneCtx& ctx, int bundle_num) {
+  auto& bundle = ctx.bundle;
   if(bundle_num == BINK_SRC_COLORS) {
     for(int i=0; i<16; i++)
-      readTree(gb, col_high[i]);
-    col_lastval = 0;
+      readTree(gb, ctx.col_high[i]);
+    ctx.col_lastval = 0;
     }
 
   if(bundle_num != BINK_SRC_INTRA_DC && bundle_num != BINK_SRC_INTER_DC)
@@ -1433,7 +1517,10 @@ void Video::readBlockTypes(BitStream& gb, Bundle& b) {
     }
   }
 
-void Video::readColors(BitStream& gb, Bundle& b) {
+void Video::readColors(BitStream& gb, PlaneCtx& ctx) {
+  auto& b           = ctx.bundle[BINK_SRC_COLORS];
+  auto& col_high    = ctx.col_high;
+  auto& col_lastval = ctx.col_lastval;
   int t=0, sign=0, v=0;
   const uint8_t *dec_end = nullptr;
 
@@ -1581,7 +1668,14 @@ void Video::readRuns(BitStream& gb, Bundle& b) {
     }
   }
 
-int Video::getValue(Sources b) {
+void Video::getMotionBlock(const Frame::Plane& last, int x, int y, uint8_t* out) {
+  if(!last.hasPixels8x8(x,y))
+    throw VideoDecodingException("motion vector out of frame bounds");
+  last.getPixels8x8(x,y,out);
+  }
+
+int Video::getValue(PlaneCtx& ctx, Sources b) {
+  auto& bundle = ctx.bundle;
   if(b<BINK_SRC_X_OFF || b==BINK_SRC_RUN)
     return *bundle[int(b)].cur_ptr++;
   if(b==BINK_SRC_X_OFF || b==BINK_SRC_Y_OFF)
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <condition_variable>
 #include <cstdint>
+#include <exception>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
 #include <vector>
 
 #include "frame.h"
@@ -78,6 +82,12 @@ class Video final {
       BINK_AUD_USEDCT = 0x1000,
       };
 
+    enum ChromaOffset : uint8_t {
+      CHROMA_OFFSET_UNKNOWN = 0, // not yet checked against the bitstream
+      CHROMA_OFFSET_VALID,       // matched end of luma on a sequentially decoded frame
+      CHROMA_OFFSET_INVALID,
+      };
+
     enum Sources {
       BINK_SRC_BLOCK_TYPES = 0, // 8x8 block types
       BINK_SRC_SUB_BLOCK_TYPES, // 16x16 block types (a subset of 8x8 block types)
@@ -137,6 +147,13 @@ class Video final {
       uint8_t*             cur_ptr  = nullptr; // pointer to the data that is not read from buffer yet
       };
 
+    // per-plane decoder state; alpha+luma and chroma planes are decoded concurrently
+    struct PlaneCtx final {
+      Bundle               bundle[BINK_NB_SRC] = {};
+      Tree                 col_high[16];         // trees for decoding high nibble in "colours" data type
+      int                  col_lastval = 0;      // value of last decoded high nibble in "colours" data type
+      };
+
     struct AudioCtx final {
       AudioCtx(uint16_t sampleRate, uint8_t channelsCnt, bool isDct);
 
@@ -180,13 +197,17 @@ class Video final {
     int      getVlc2(BitStream& gb, int16_t (*table)[2], int bits, int max_depth);
     void     readPacket();
     void     parseFrame(const std::vector<uint8_t>& data);
-    void     decodePlane(BitStream& gb, int planeId, bool chroma);
-    void     initLengths(int width, int bw);
-    void     readBundle(BitStream& gb, int bundle_num);
+    void     decodePlane(BitStream& gb, PlaneCtx& ctx, int planeId, bool chroma);
+    void     decodeChroma(BitStream& gb, PlaneCtx& ctx, size_t bitsCount);
+    void     chromaThreadFunc();
+    void     startChroma(BitStream& gb, size_t bitsCount);
+    void     waitChroma();
+    void     initLengths(PlaneCtx& ctx, int width, int bw);
+    void     readBundle(BitStream& gb, PlaneCtx& ctx, int bundle_num);
     void     readTree(BitStream& gb, Tree& tree);
 
     void     readBlockTypes  (BitStream& gb, Bundle& b);
-    void     readColors      (BitStream& gb, Bundle& b);
+    void     readColors      (BitStream& gb, PlaneCtx& ctx);
     void     readPatterns    (BitStream& gb, Bundle& b);
     void     readMotionValues(BitStream& gb, Bundle& b);
     void     readDcs         (BitStream& gb, Bundle& b, int start_bits, int has_sign);
@@ -196,7 +217,8 @@ class Video final {
     void     unquantizeDctCoeffs(int32_t block[], const uint32_t quant[],
                                  int coef_count, int coef_idx[], const uint8_t* scan);
     void     readResidue     (BitStream& gb, int16_t block[], int masks_count);
-    int      getValue(Sources bundle);
+    static int getValue(PlaneCtx& ctx, Sources bundle);
+    static void getMotionBlock(const Frame::Plane& last, int x, int y, uint8_t* out);
     template<class T>
     static bool checkReadVal(BitStream& gb, Bundle& b, T& t);
 
@@ -228,9 +250,17 @@ class Video final {
     uint32_t                frameCounter = 0;
 
     // video
-    Bundle                  bundle[BINK_NB_SRC] = {};
-    Tree                    col_high[16];         // trees for decoding high nibble in "colours" data type
-    int                     col_lastval = 0;      // value of last decoded high nibble in "colours" data type
+    PlaneCtx                planeCtx[2];
+    ChromaOffset            chromaOffset = CHROMA_OFFSET_UNKNOWN;
+
+    // chroma planes decoder, runs concurrently with luma
+    std::thread             chromaThread;
+    std::mutex              chromaSync;
+    std::condition_variable chromaCv;
+    BitStream*              chromaGb    = nullptr; // pending task, reset when done
+    size_t                  chromaBits  = 0;
+    bool                    chromaStop  = false;
+    std::exception_ptr      chromaErr;
 
     // sound
     float                   quantTable[96] = {};
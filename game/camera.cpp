@@ -9,6 +9,8 @@
 #include "utils/dbgpainter.h"
 #include "gothic.h"
 
+#include <chrono>
+
 using namespace Tempest;
 
 static float angleMod(float a) {
@@ -49,6 +51,7 @@ void Camera::reset(const Npc* pl) {
 
   src.spin   = dst.spin;
 
+  colCache.valid = false;
   calcControlPoints(-1.f);
   }
 
@@ -560,22 +563,84 @@ Vec3 Camera::calcOffsetAngles(Vec3 srcOrigin, Vec3 dstOrigin, Vec3 target) const
   }
 
 float Camera::calcCameraColision(const Vec3& target, const Vec3& origin, const Vec3& rotSpin, float dist) const {
+  auto  t0  = std::chrono::steady_clock::now();
+  float ret = implCameraColision(target,origin,rotSpin,dist);
+  auto  t1  = std::chrono::steady_clock::now();
+  colisionTime = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(t1-t0).count());
+  return ret;
+  }
+
+float Camera::implCameraColision(const Vec3& target, const Vec3& origin, const Vec3& rotSpin, float dist) const {
   if(camMod==Dialog)
     dist = dlgDist;
 
+  raysCasted    = 0;
+  spheresCasted = 0;
+  colCacheHit   = false;
+
   auto world = Gothic::inst().world();
-  if(world==nullptr)
+  if(world==nullptr) {
+    colCache.valid = false;
     return dist;
+    }
+
+  // camera that didn't move can reuse last frame result; sweep hits landscape and objects,
+  // so a moving door or chest lid is picked up once the camera moves again
+  const float eps = 0.01f;
+  if(colCache.valid && colCache.dist==dist &&
+     (colCache.target-target).quadLength()<eps && (colCache.origin-origin).quadLength()<eps) {
+    colCacheHit = true;
+    return colCache.result;
+    }
 
-  float minDist = 20;
-  float padding = 20;
+  const float minDist = 20;
+  const float padding = 20;
 
   auto& physic = *world->physic();
   Matrix4x4 vinv=projective();
   vinv.mul(mkView(origin,rotSpin));
   vinv.inverse();
 
-  raysCasted = 0;
+  // sphere, that covers near plane of the camera
+  Vec3  center = {0,0,0};
+  vinv.project(center.x,center.y,center.z);
+  float radius = 0;
+  for(float u:{-1.f,1.f})
+    for(float v:{-1.f,1.f}) {
+      Vec3 corner = {u,v,0};
+      vinv.project(corner.x,corner.y,corner.z);
+      radius = std::max(radius,(corner-center).length());
+      }
+
+  float distMd = dist;
+  auto  rc     = physic.sphereCast(target,center,radius);
+  spheresCasted++;
+  if(rc.hasCol && rc.hitFraction<=0.f) {
+    // sphere overlaps geometry at the start - ambiguous, use precise ray-test
+    distMd = rayGridColision(target,origin,vinv,dist);
+    } else
+  if(rc.hasCol) {
+    float dist0 = (center-target).length();
+    float dist1 = std::max<float>(0,(rc.v-target).length()-padding);
+    distMd = dist-std::max(0.f,dist0-dist1);
+    }
+
+  colCache.target = target;
+  colCache.origin = origin;
+  colCache.dist   = dist;
+  colCache.result = std::max(minDist,distMd);
+  colCache.valid  = true;
+  return colCache.result;
+  }
+
+float Camera::rayGridColision(const Vec3& target, const Vec3& origin, const Matrix4x4& vinv, float dist) const {
+  auto world = Gothic::inst().world();
+  if(world==nullptr)
+    return dist;
+
+  const float padding = 20;
+
+  auto& physic = *world->physic();
   float distMd = dist;
   auto  tr     = origin - target;
   static int n = 1, nn=1;
@@ -603,7 +668,7 @@ float Camera::calcCameraColision(const Vec3& target, const Vec3& origin, const V
       if(md<distMd)
         distMd=md;
       }
-  return std::max(minDist,distMd);
+  return distMd;
   }
 
 Matrix4x4 Camera::mkView(const Vec3& pos, const Vec3& spin) const {
@@ -653,7 +718,10 @@ void Camera::debugDraw(DbgPainter& p) {
   int   y   = 300+fnt.pixelSize();
   char  buf[256] = {};
 
-  std::snprintf(buf,sizeof(buf),"RaysCasted : %d", raysCasted);
+  std::snprintf(buf,sizeof(buf),"RaysCasted : %d, SpheresCasted : %d%s", raysCasted, spheresCasted, (colCacheHit ? " (cached)" : ""));
+  p.drawText(8,y,buf); y += fnt.pixelSize();
+
+  std::snprintf(buf,sizeof(buf),"Collision time : %d us", int(colisionTime));
   p.drawText(8,y,buf); y += fnt.pixelSize();
 
   std::snprintf(buf,sizeof(buf),"PlayerPos : %f %f %f", dst.target.x, dst.target.y, dst.target.z);
@@ -57,6 +57,7 @@ class Camera final {
     void setLookBack(bool lb);
 
     void toogleDebug();
+    bool isDebug() const { return dbg; }
 
     void tick(uint64_t dt);
     void debugDraw(DbgPainter& p);
@@ -109,7 +110,19 @@ class Camera final {
     bool                  inertiaTarget = true;
     Mode                  camMod        = Normal;
 
-    mutable int           raysCasted = 0;
+    struct ColisionCache {
+      Tempest::Vec3       target = {};
+      Tempest::Vec3       origin = {};
+      float               dist   = 0;
+      float               result = 0;
+      bool                valid  = false;
+      };
+
+    mutable ColisionCache colCache;
+    mutable int           raysCasted    = 0;
+    mutable int           spheresCasted = 0;
+    mutable bool          colCacheHit   = false;
+    mutable uint64_t      colisionTime  = 0; // microseconds
 
     static float          maxDist;
     static float          baseSpeeed;
@@ -120,6 +133,8 @@ class Camera final {
     Tempest::Vec3         calcOffsetAngles(const Tempest::Vec3& srcOrigin, const Tempest::Vec3& target) const;
     Tempest::Vec3         calcOffsetAngles(Tempest::Vec3 srcOrigin, Tempest::Vec3 dstOrigin, Tempest::Vec3 target) const;
     float                 calcCameraColision(const Tempest::Vec3& target, const Tempest::Vec3& origin, const Tempest::Vec3& rotSpin, float dist) const;
+    float                 implCameraColision(const Tempest::Vec3& target, const Tempest::Vec3& origin, const Tempest::Vec3& rotSpin, float dist) const;
+    float                 rayGridColision(const Tempest::Vec3& target, const Tempest::Vec3& origin, const Tempest::Matrix4x4& vinv, float dist) const;
 
     void                  implMove(Tempest::KeyEvent::KeyType t);
     Tempest::Matrix4x4    mkView    (const Tempest::Vec3& pos, const Tempest::Vec3& spin) const;
@@ -3,6 +3,9 @@
 #include <Tempest/Log>
 #include <Tempest/TextCodec>
 #include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <limits>
 
 #include "gothic.h"
 
@@ -62,6 +65,28 @@ CommandLine::CommandLine(int argc, const char** argv) {
     else if(arg=="-g2") {
       forceG2 = true;
       }
+    else if(arg=="-musiccache") {
+      musicCache = true;
+      }
+    else if(arg=="-profile") {
+      profile = true;
+      }
+    else if(arg=="-memlog") {
+      memLog = true;
+      }
+    else if(arg=="-benchmark") {
+      ++i;
+      char* end     = nullptr;
+      long  minutes = (i<argc) ? std::strtol(argv[i],&end,10) : 0;
+      if(i>=argc || end==argv[i] || *end!='\0' || minutes<=0) {
+        Log::e("-benchmark expects a number of simulated minutes; flag ignored");
+        if(i<argc && argv[i][0]=='-')
+          --i; // next flag, not an argument
+        continue;
+        }
+      benchmark = uint32_t(std::min<long>(minutes,std::numeric_limits<int32_t>::max()));
+      noMenu    = true;
+      }
     else if(arg=="-dx12") {
       graphics = GraphicBackend::DirectX12;
       }
@@ -30,6 +30,10 @@ class CommandLine {
     bool                doStartMenu()   const { return !noMenu;  }
     bool                doForceG1()     const { return forceG1;  }
     bool                doForceG2()     const { return forceG2;  }
+    bool                doMusicCache()  const { return musicCache; }
+    bool                doProfile()     const { return profile;  }
+    bool                doMemoryLog()   const { return memLog;   }
+    uint32_t            benchmarkTime() const { return benchmark; } // simulated minutes, 0 - off
     std::string_view    defaultSave()   const { return saveDef;  }
 
     std::string         wrldDef;
@@ -52,5 +56,9 @@ class CommandLine {
     bool                isMeshSh = true;
     bool                forceG1  = false;
     bool                forceG2  = false;
+    bool                musicCache = false;
+    bool                profile  = false;
+    bool                memLog   = false;
+    uint32_t            benchmark = 0;
   };
 
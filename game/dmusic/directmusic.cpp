@@ -25,6 +25,20 @@ PatternList DirectMusic::load(const char16_t *fsgt) {
   return load(sgt);
   }
 
+uint64_t DirectMusic::fileHash(const char16_t* file) {
+  Tempest::RFile fin = implOpen(file);
+  std::vector<uint8_t> v(size_t(fin.size()));
+  fin.read(v.data(),v.size());
+
+  // FNV-1a
+  uint64_t h = 14695981039346656037ull;
+  for(auto b:v) {
+    h ^= b;
+    h *= 1099511628211ull;
+    }
+  return h;
+  }
+
 void DirectMusic::addPath(std::u16string p) {
   path.emplace_back(std::move(p));
   }
@@ -22,6 +22,7 @@ class DirectMusic final {
 
     PatternList          load(const Segment& s);
     PatternList          load(const char16_t* fsgt);
+    uint64_t             fileHash(const char16_t* file);
 
     void addPath(std::u16string path);
 
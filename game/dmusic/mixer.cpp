@@ -4,6 +4,7 @@
 #include <Tempest/SoundEffect>
 #include <Tempest/Sound>
 #include <Tempest/Log>
+#include <algorithm>
 #include <cmath>
 #include <set>
 
@@ -47,6 +48,14 @@ int64_t Mixer::currentPlayTime() const {
   return (sampleCursor*1000/SoundFont::SampleRate);
   }
 
+size_t Mixer::firstNoteAfter(const PatternInternal& part, int64_t time) {
+  // waves are sorted by time, see PatternList::index
+  auto it = std::upper_bound(part.waves.begin(),part.waves.end(),time,[](int64_t t, const PatternList::Note& n){
+    return t<toSamples(n.at);
+    });
+  return size_t(std::distance(part.waves.begin(),it));
+  }
+
 int64_t Mixer::nextNoteOn(PatternList::PatternInternal& part,int64_t b,int64_t e) {
   int64_t nextDt    = std::numeric_limits<int64_t>::max();
   int64_t timeTotal = toSamples(part.timeTotal);
@@ -55,6 +64,18 @@ int64_t Mixer::nextNoteOn(PatternList::PatternInternal& part,int64_t b,int64_t e
   b-=patStart;
   e-=patStart;
 
+  if(!inv) {
+    for(size_t i=firstNoteAfter(part,b); i<part.waves.size(); ++i) {
+      auto&   w  = part.waves[i];
+      int64_t at = toSamples(w.at);
+      if(at>e)
+        break;
+      if(w.duration>0)
+        return at-b;
+      }
+    return nextDt;
+    }
+
   for(auto& i:part.waves) {
     int64_t at = toSamples(i.at);
     if((b<at && at<=e)^inv) {
@@ -70,15 +91,10 @@ int64_t Mixer::nextNoteOn(PatternList::PatternInternal& part,int64_t b,int64_t e
   }
 
 int64_t Mixer::nextNoteOff(int64_t b, int64_t /*e*/) {
-  int64_t actT = std::numeric_limits<int64_t>::max();
-
-  for(auto& i:active) {
-    int64_t at = i.at;
-    int64_t dt = at>b ? at-b : 0;
-    if(dt<actT)
-      actT = dt;
-    }
-  return actT;
+  if(active.size()==0)
+    return std::numeric_limits<int64_t>::max();
+  int64_t at = active[0].at;
+  return at>b ? at-b : 0;
   }
 
 void Mixer::noteOn(std::shared_ptr<PatternInternal>& pattern, PatternList::Note *r) {
@@ -91,34 +107,35 @@ void Mixer::noteOn(std::shared_ptr<PatternInternal>& pattern, PatternList::Note
   if(a.ticket==nullptr)
     return;
 
-  for(auto& i:uniqInstr)
-    if(i.ptr==r->inst) {
-      a.parent = &i;
-      a.parent->counter++;
-      active.push_back(a);
-      return;
-      }
-  Instr u;
-  u.ptr     = r->inst;
-  u.pattern = pattern;
-  uniqInstr.push_back(u);
-
-  a.parent = &uniqInstr.back();
+  auto ins = instrIndex.find(r->inst);
+  if(ins!=instrIndex.end()) {
+    a.parent = ins->second;
+    } else {
+    Instr u;
+    u.ptr     = r->inst;
+    u.pattern = pattern;
+    uniqInstr.push_back(u);
+    a.parent = &uniqInstr.back();
+    instrIndex[r->inst] = a.parent;
+    }
   a.parent->counter++;
 
-  active.push_back(a);
+  auto at = std::upper_bound(active.begin(),active.end(),a.at,[](int64_t t, const Active& a){
+    return t<a.at;
+    });
+  active.insert(at,a);
   }
 
 void Mixer::noteOn(std::shared_ptr<PatternInternal>& pattern, int64_t time) {
   time-=patStart;
 
-  size_t n=0;
-  for(auto& i:pattern->waves) {
-    int64_t at = toSamples(i.at);
-    if(at==time) {
-      noteOn(pattern,&i);
-      ++n;
-      }
+  auto&  waves = pattern->waves;
+  size_t n     = 0;
+  for(size_t i=firstNoteAfter(*pattern,time-1); i<waves.size(); ++i) {
+    if(toSamples(waves[i].at)!=time)
+      break;
+    noteOn(pattern,&waves[i]);
+    ++n;
     }
   if(n==0)
     throw std::runtime_error("mixer critical error");
@@ -126,16 +143,11 @@ void Mixer::noteOn(std::shared_ptr<PatternInternal>& pattern, int64_t time) {
 
 void Mixer::noteOff(int64_t time) {
   size_t sz=0;
-  for(size_t i=0;i<active.size();++i){
-    if(active[i].at>time) {
-      active[sz]=active[i];
-      sz++;
-      } else {
-      SoundFont::noteOff(active[i].ticket);
-      active[i].parent->counter--;
-      }
+  for(;sz<active.size() && active[sz].at<=time; ++sz) {
+    SoundFont::noteOff(active[sz].ticket);
+    active[sz].parent->counter--;
     }
-  active.resize(sz);
+  active.erase(active.begin(),active.begin()+int64_t(sz));
   }
 
 void Mixer::nextPattern() {
@@ -299,8 +311,12 @@ void Mixer::mix(int16_t *out, size_t samples) {
       }
     }
 
-  uniqInstr.remove_if([](Instr& i){
-    return i.counter==0 && !i.ptr->font.hasNotes();
+  uniqInstr.remove_if([this](Instr& i){
+    if(i.counter==0 && !i.ptr->font.hasNotes()) {
+      instrIndex.erase(i.ptr);
+      return true;
+      }
+    return false;
     });
   }
 
@@ -329,24 +345,30 @@ void Mixer::implMix(PatternInternal &pptn, float volume, int16_t *out, size_t cn
       // HACK
       // insVolume*=0.10f;
       }
+    // plain loops without branches - vectorized by compiler
+    float*       dst = pcmMix.data();
+    const float* src = pcm.data();
     const bool hasVol = hasVolumeCurves(pptn,i);
     if(hasVol) {
       volFromCurve(pptn,i,vol);
-      for(size_t r=0;r<cnt2;++r) {
-        float v = vol[r/2];
-        pcmMix[r] += pcm[r]*insVolume*(v*v);
+      float* gain = vol.data();
+      for(size_t r=0;r<cnt;++r)
+        gain[r] = insVolume*gain[r]*gain[r];
+      for(size_t r=0;r<cnt;++r) {
+        dst[r*2+0] += src[r*2+0]*gain[r];
+        dst[r*2+1] += src[r*2+1]*gain[r];
         }
       } else {
-      for(size_t r=0;r<cnt2;++r) {
-        float v = i.volLast;
-        pcmMix[r] += pcm[r]*insVolume*(v*v);
-        }
+      const float gain = insVolume*i.volLast*i.volLast;
+      for(size_t r=0;r<cnt2;++r)
+        dst[r] += src[r]*gain;
       }
     }
 
+  const float* src = pcmMix.data();
   for(size_t i=0;i<cnt2;++i) {
-    float v = pcmMix[i]*volume;
-    out[i] = (v < -1.00004566f ? int16_t(-32768) : (v > 1.00001514f ? int16_t(32767) : int16_t(v * 32767.5f)));
+    float v = std::min(std::max(src[i]*volume,-1.f),1.f);
+    out[i] = int16_t(v*32767.5f);
     }
   }
 
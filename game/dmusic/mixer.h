@@ -8,6 +8,7 @@
 #include <thread>
 #include <atomic>
 #include <list>
+#include <unordered_map>
 
 #include "patternlist.h"
 #include "music.h"
@@ -67,6 +68,7 @@ class Mixer final {
 
     bool     hasVolumeCurves(PatternInternal &part, Instr &ins) const;
     void     volFromCurve(PatternInternal &part, Instr &ins, std::vector<float> &v);
+    static size_t firstNoteAfter(const PatternInternal &part, int64_t time);
 
     template<class T>
     bool     checkVariation(const T& item) const;
@@ -84,8 +86,9 @@ class Mixer final {
     std::atomic<size_t>                grooveCounter={};
 
     std::atomic<float>                 volume={1.f};
-    std::vector<Active>                active;
+    std::vector<Active>                active; // sorted by Active::at
     std::list<Instr>                   uniqInstr;
+    std::unordered_map<const PatternList::InsInternal*,Instr*> instrIndex;
     std::vector<float>                 pcm, vol, pcmMix;
   };
 
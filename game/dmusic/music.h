@@ -18,6 +18,8 @@ class Music final {
 
     void   clear() { impl->pptn.clear(); }
     size_t size() const { return impl->pptn.size(); }
+    // total length of all patterns, in milliseconds
+    uint64_t duration() const { return impl->timeTotal; }
 
     void   setVolume(float v);
 
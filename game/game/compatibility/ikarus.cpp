@@ -53,6 +53,8 @@ Ikarus::Ikarus(GameScript& /*owner*/, Daedalus::DaedalusVM& vm)
   // ## Basic Read Write ##
   vm.registerInternalFunction("MEM_ReadInt",                  [this](Daedalus::DaedalusVM& vm){ mem_readint(vm);        });
   vm.registerInternalFunction("MEM_WriteInt",                 [this](Daedalus::DaedalusVM& vm){ mem_writeint(vm);       });
+  vm.registerInternalFunction("MEM_ReadByte",                 [this](Daedalus::DaedalusVM& vm){ mem_readbyte(vm);       });
+  vm.registerInternalFunction("MEM_WriteByte",                [this](Daedalus::DaedalusVM& vm){ mem_writebyte(vm);      });
   vm.registerInternalFunction("MEM_CopyBytes",                [this](Daedalus::DaedalusVM& vm){ mem_copybytes(vm);      });
   vm.registerInternalFunction("MEM_GetCommandLine",           [this](Daedalus::DaedalusVM& vm){ mem_getcommandline(vm); });
 
@@ -141,6 +143,22 @@ void Ikarus::mem_writeint(Daedalus::DaedalusVM& vm) {
   allocator.writeInt(address,val);
   }
 
+void Ikarus::mem_readbyte(Daedalus::DaedalusVM& vm) {
+  const auto address = vm.popInt();
+  uint8_t    v       = 0;
+  allocator.readBytes(ptr32_t(address),&v,1);
+  vm.setReturn(int32_t(v));
+  }
+
+void Ikarus::mem_writebyte(Daedalus::DaedalusVM& vm) {
+  auto val     = vm.popInt();
+  auto address = ptr32_t(vm.popInt());
+  if(val<0 || val>=256)
+    Log::e("MEM_WriteByte: only the lowest byte of ", val, " is written");
+  uint8_t v = uint8_t(val);
+  allocator.writeBytes(address,&v,1);
+  }
+
 void Ikarus::mem_copybytes(Daedalus::DaedalusVM& vm) {
   auto size = uint32_t(vm.popInt());
   auto dst  = uint32_t(vm.popInt());
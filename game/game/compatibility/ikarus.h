@@ -40,6 +40,8 @@ class Ikarus : public ScriptPlugin {
     // ## Basic Read Write ##
     void  mem_readint                       (Daedalus::DaedalusVM &vm);
     void  mem_writeint                      (Daedalus::DaedalusVM &vm);
+    void  mem_readbyte                      (Daedalus::DaedalusVM &vm);
+    void  mem_writebyte                     (Daedalus::DaedalusVM &vm);
     void  mem_copybytes                     (Daedalus::DaedalusVM &vm);
     void  mem_getcommandline                (Daedalus::DaedalusVM &vm);
 
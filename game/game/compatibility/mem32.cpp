@@ -2,6 +2,7 @@
 
 #include <Tempest/Log>
 #include <cstring>
+#include <cstdlib>
 #include <algorithm>
 
 using namespace Tempest;
@@ -12,114 +13,165 @@ Mem32::Mem32() {
    *  [0x80000000 .. 0xc0000000] - (1GB) extra space(reserved for opengothic use; pinned memory)
    *  [0xc0000000 .. 0xffffffff] - (1GB) kernel space
    */
-  region.emplace_back(Region(0x1000,0x80000000));
+  auto& rgn = region.emplace(0x1000,Region(0x1000,0x80000000)).first->second;
+  addFree(rgn);
   }
 
 Mem32::~Mem32() {
-  for(auto& rgn:region) {
+  for(auto& i:region) {
+    auto& rgn = i.second;
     if(rgn.status==S_Allocated && rgn.real!=nullptr) {
       std::free(rgn.real);
       rgn.real = nullptr;
       }
     }
+  for(auto& s:slab)
+    for(auto ptr:s)
+      std::free(ptr);
   }
 
 Mem32::ptr32_t Mem32::pin(void* mem, ptr32_t address, uint32_t size, const char* comment) {
-  for(size_t i=0; i<region.size(); ++i) {
-    auto& rgn = region[i];
-
-    if(address!=0) {
-      if(!(rgn.address<=address && address+size<=rgn.address+rgn.size))
-        continue;
-      } else {
-      if(rgn.size<size)
-        continue;
-      }
-
-    if(rgn.status!=S_Unused) {
-      Log::e("failed to pin a ",size," bytes of memory: block is in use");
+  Region* rgn = nullptr;
+  if(address!=0) {
+    rgn = translate(address);
+    if(rgn==nullptr || uint64_t(address)+size>uint64_t(rgn->address)+rgn->size) {
+      Log::e("failed to pin a ",size," bytes of memory: address is out of range");
       return 0;
       }
-
-    if(address==0)
-      address = region[i].address;
-
-    if(region[i].address<address) {
-      uint32_t off = (address-region[i].address);
-      auto p2 = region[i];
-      p2.address+=off;
-      p2.size   -=off;
-      region.insert(region.begin()+ptrdiff_t(i+1),p2);
-      region[i].size = off;
-      ++i;
-      }
-    if(size!=region[i].size) {
-      auto p2 = region[i];
-      p2.address+=size;
-      p2.size   -=size;
-      region.insert(region.begin()+ptrdiff_t(i+1),p2);
+    } else {
+    auto it = freeBySize.lower_bound(std::make_pair(size,ptr32_t(0)));
+    if(it!=freeBySize.end()) {
+      rgn     = &region.find(it->second)->second;
+      address = rgn->address;
       }
+    }
 
-    region[i].size    = size;
-    region[i].real    = mem;
-    region[i].status  = S_Pin;
-    region[i].comment = comment;
+  if(rgn==nullptr) {
+    Log::e("failed to pin a ",size," bytes of memory: out of address space");
+    return 0;
+    }
+  if(rgn->status!=S_Unused) {
+    Log::e("failed to pin a ",size," bytes of memory: block is in use");
+    return 0;
     }
-  return 0;
+
+  rgn = split(*rgn,address,size);
+  rgn->real    = mem;
+  rgn->status  = S_Pin;
+  rgn->comment = comment;
+  return address;
   }
 
 Mem32::ptr32_t Mem32::alloc(uint32_t size) {
-  size = ((size+memAlign-1)/memAlign)*memAlign;
-
-  for(size_t i=0; i<region.size(); ++i) {
-    if(region[i].status!=S_Unused || region[i].size<size)
-      continue;
-    if(size!=region[i].size) {
-      auto p2 = region[i];
-      p2.address+=size;
-      p2.size   -=size;
-      region.insert(region.begin()+ptrdiff_t(i+1),p2);
-      }
-    region[i].size   = size;
-    region[i].real   = std::calloc(size,1);
-    if(region[i].real!=nullptr) {
-      region[i].status = S_Allocated;
-      return region[i].address;
-      } else {
-      compactage();
-      return 0;
-      }
-    }
-  return 0;
+  size = std::max(((size+memAlign-1)/memAlign)*memAlign, memAlign);
+
+  // best fit
+  auto it = freeBySize.lower_bound(std::make_pair(size,ptr32_t(0)));
+  if(it==freeBySize.end())
+    return 0;
+
+  void* real = hostAlloc(size);
+  if(real==nullptr)
+    return 0;
+
+  auto& free = region.find(it->second)->second;
+  auto  rgn  = split(free,free.address,size);
+  rgn->real   = real;
+  rgn->status = S_Allocated;
+  return rgn->address;
   }
 
 void Mem32::free(ptr32_t address) {
   if(address==0)
     return;
-  for(size_t i=0; i<region.size(); ++i) {
-    if(region[i].address!=address)
-      continue;
-    std::free(region[i].real);
-    region[i].real   = nullptr;
-    region[i].status = S_Unused;
-    compactage();
+  auto it = region.find(address);
+  if(it==region.end() || it->second.status!=S_Allocated) {
+    Log::e("mem_free: heap block wan't allocated by script: ", reinterpret_cast<void*>(uint64_t(address)));
     return;
     }
-  Log::e("mem_free: heap block wan't allocated by script: ", reinterpret_cast<void*>(uint64_t(address)));
+  auto& rgn = it->second;
+  hostFree(rgn.real,rgn.size);
+  rgn.real   = nullptr;
+  rgn.status = S_Unused;
+  release(rgn);
   }
 
-void Mem32::compactage() {
-  for(size_t i=0; i+1<region.size(); ) {
-    auto& a = region[i+0];
-    auto& b = region[i+1];
-    if(a.status==S_Unused && a.status==b.status && a.address+a.size==b.address) {
-      a.size += b.size;
-      b.size = 0;
-      region.erase(region.begin()+ptrdiff_t(i+1));
-      } else {
-      ++i;
+Mem32::Region* Mem32::split(Region& rgn, ptr32_t address, uint32_t size) {
+  // cut [address, address+size) out of unused region
+  removeFree(rgn);
+  last = nullptr;
+
+  const ptr32_t end = rgn.address+rgn.size;
+  if(rgn.address<address) {
+    rgn.size = address-rgn.address;
+    addFree(rgn);
+    } else {
+    region.erase(rgn.address);
+    }
+
+  auto& ret = region.emplace(address,Region(address,size)).first->second;
+  if(address+size<end) {
+    auto& tail = region.emplace(address+size,Region(address+size,end-address-size)).first->second;
+    addFree(tail);
+    }
+  return &ret;
+  }
+
+void Mem32::release(Region& r) {
+  // merge with unused neighbours
+  last = nullptr;
+
+  auto it = region.find(r.address);
+  auto nx = std::next(it);
+  if(nx!=region.end() && nx->second.status==S_Unused && r.address+r.size==nx->second.address) {
+    removeFree(nx->second);
+    it->second.size += nx->second.size;
+    region.erase(nx);
+    }
+  if(it!=region.begin()) {
+    auto pr = std::prev(it);
+    if(pr->second.status==S_Unused && pr->second.address+pr->second.size==it->second.address) {
+      removeFree(pr->second);
+      pr->second.size += it->second.size;
+      region.erase(it);
+      it = pr;
       }
     }
+  addFree(it->second);
+  }
+
+void Mem32::addFree(const Region& rgn) {
+  freeBySize.emplace(rgn.size,rgn.address);
+  }
+
+void Mem32::removeFree(const Region& rgn) {
+  freeBySize.erase(std::make_pair(rgn.size,rgn.address));
+  }
+
+void* Mem32::hostAlloc(uint32_t size) {
+  if(size<=SlabMax) {
+    auto& s = slab[size/memAlign-1];
+    if(!s.empty()) {
+      void* ptr = s.back();
+      s.pop_back();
+      std::memset(ptr,0,size);
+      return ptr;
+      }
+    }
+  return std::calloc(size,1);
+  }
+
+void Mem32::hostFree(void* ptr, uint32_t size) {
+  if(ptr==nullptr)
+    return;
+  if(size<=SlabMax) {
+    auto& s = slab[size/memAlign-1];
+    if(s.size()<SlabKeep) {
+      s.push_back(ptr);
+      return;
+      }
+    }
+  std::free(ptr);
   }
 
 void Mem32::writeInt(ptr32_t address, int32_t v) {
@@ -129,6 +181,10 @@ void Mem32::writeInt(ptr32_t address, int32_t v) {
     return;
     }
   address -= rgn->address;
+  if(address+4>rgn->size) {
+    Log::e("mem_writeint: write exceed block size: ", reinterpret_cast<void*>(uint64_t(rgn->address+address)));
+    return;
+    }
   auto ptr = reinterpret_cast<uint8_t*>(rgn->real)+address;
   std::memcpy(ptr,&v,4);
   }
@@ -140,6 +196,10 @@ int32_t Mem32::readInt(ptr32_t address) {
     return 0;
     }
   address -= rgn->address;
+  if(address+4>rgn->size) {
+    Log::e("mem_readint: read exceed block size: ", reinterpret_cast<void*>(uint64_t(rgn->address+address)));
+    return 0;
+    }
   auto ptr = reinterpret_cast<uint8_t*>(rgn->real)+address;
   int32_t ret = 0;
   std::memcpy(&ret,ptr,4);
@@ -169,15 +229,55 @@ void Mem32::copyBytes(ptr32_t psrc, ptr32_t pdst, uint32_t size) {
     Log::e("mem_copybytes: copy-size exceed destination block size: ", size);
     sz = std::min(dst->size-dOff,sz);
     }
-  std::memcpy(reinterpret_cast<uint8_t*>(dst->real)+sOff,
-              reinterpret_cast<uint8_t*>(src->real)+dOff,
-              sz);
+  std::memmove(reinterpret_cast<uint8_t*>(dst->real)+dOff,
+               reinterpret_cast<uint8_t*>(src->real)+sOff,
+               sz);
   }
 
-Mem32::Region* Mem32::translate(ptr32_t address) {
-  for(auto& rgn:region) {
-    if(rgn.address<=address && address<rgn.address+rgn.size)
-      return &rgn;
+void Mem32::readBytes(ptr32_t address, void* dst, uint32_t size) {
+  auto rgn = translate(address);
+  if(rgn==nullptr || rgn->status==S_Unused) {
+    Log::e("mem_readbytes: address translation failure: ", reinterpret_cast<void*>(uint64_t(address)));
+    std::memset(dst,0,size);
+    return;
+    }
+  size_t off = address - rgn->address;
+  size_t sz  = size;
+  if(rgn->size<off+size) {
+    Log::e("mem_readbytes: read-size exceed block size: ", size);
+    sz = rgn->size-off;
+    std::memset(reinterpret_cast<uint8_t*>(dst)+sz,0,size-sz);
+    }
+  std::memcpy(dst,reinterpret_cast<uint8_t*>(rgn->real)+off,sz);
+  }
+
+void Mem32::writeBytes(ptr32_t address, const void* src, uint32_t size) {
+  auto rgn = translate(address);
+  if(rgn==nullptr || rgn->status==S_Unused) {
+    Log::e("mem_writebytes: address translation failure: ", reinterpret_cast<void*>(uint64_t(address)));
+    return;
     }
-  return nullptr;
+  size_t off = address - rgn->address;
+  size_t sz  = size;
+  if(rgn->size<off+size) {
+    Log::e("mem_writebytes: write-size exceed block size: ", size);
+    sz = rgn->size-off;
+    }
+  std::memcpy(reinterpret_cast<uint8_t*>(rgn->real)+off,src,sz);
+  }
+
+Mem32::Region* Mem32::translate(ptr32_t address) {
+  // scripts tend to access same block in a loop
+  if(last!=nullptr && last->address<=address && uint64_t(address)<uint64_t(last->address)+last->size)
+    return last;
+
+  auto it = region.upper_bound(address);
+  if(it==region.begin())
+    return nullptr;
+  --it;
+  auto& rgn = it->second;
+  if(uint64_t(address)>=uint64_t(rgn.address)+rgn.size)
+    return nullptr;
+  last = &rgn;
+  return last;
   }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <map>
+#include <set>
 #include <vector>
 #include <memory>
 
@@ -17,7 +20,9 @@ class Mem32 {
 
     void    writeInt(ptr32_t address, int32_t v);
     int32_t readInt (ptr32_t address);
-    void    copyBytes(ptr32_t src, ptr32_t dst, uint32_t size);
+    void    copyBytes (ptr32_t src, ptr32_t dst, uint32_t size);
+    void    readBytes (ptr32_t address, void* dst, uint32_t size);
+    void    writeBytes(ptr32_t address, const void* src, uint32_t size);
 
   private:
     enum Status:uint8_t {
@@ -26,6 +31,13 @@ class Mem32 {
       S_Pin,
       };
 
+    enum {
+      // small script allocations recycle host memory per size class
+      SlabMax     = 256,
+      SlabClasses = SlabMax/memAlign,
+      SlabKeep    = 256,
+      };
+
     struct Region {
       Region();
       Region(ptr32_t b, uint32_t sz):address(b),size(sz){}
@@ -37,8 +49,17 @@ class Mem32 {
       };
 
     Region*  translate(ptr32_t address);
-    void     compactage();
+    Region*  split(Region& rgn, ptr32_t address, uint32_t size);
+    void     release(Region& rgn);
+    void     addFree(const Region& rgn);
+    void     removeFree(const Region& rgn);
+
+    void*    hostAlloc(uint32_t size);
+    void     hostFree(void* ptr, uint32_t size);
 
-    std::vector<Region> region;
+    std::map<ptr32_t,Region>              region;     // by address, covers whole address space
+    std::set<std::pair<uint32_t,ptr32_t>> freeBySize; // unused regions: size, address
+    Region*                               last = nullptr;
+    std::vector<void*>                    slab[SlabClasses];
   };
 
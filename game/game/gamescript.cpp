@@ -4,6 +4,7 @@
 #include <Tempest/SoundEffect>
 
 #include <fstream>
+#include <algorithm>
 #include <cctype>
 
 #include "game/definitions/spelldefinitions.h"
@@ -331,6 +332,31 @@ void GameScript::initCommon() {
   spellFxInstanceNames = dat.getSymbolIndexByName("spellFxInstanceNames");
   spellFxAniLetters    = dat.getSymbolIndexByName("spellFxAniLetters");
 
+  fnCanNotUse               = getSymbolIndex("G_CanNotUse");
+  fnCanNotCast              = getSymbolIndex("G_CanNotCast");
+  fnPickLock                = getSymbolIndex("G_PickLock");
+  fnProcessMana             = getSymbolIndex("Spell_ProcessMana");
+  fnCanNpcCollideWithSpell  = getSymbolIndex("C_CanNpcCollideWithSpell");
+  fnTradeNotEnoughGold      = getSymbolIndex("player_trade_not_enough_gold");
+  fnPlunderIsEmpty          = getSymbolIndex("player_plunder_is_empty");
+  fnHotkeyScreenMap         = getSymbolIndex("player_hotkey_screen_map");
+  fnMobMissingItem          = getSymbolIndex("player_mob_missing_item");
+  fnMobMissingKey           = getSymbolIndex("player_mob_missing_key");
+  fnMobAnotherIsUsing       = getSymbolIndex("player_mob_another_is_using");
+  fnMobMissingKeyOrLockpick = getSymbolIndex("player_mob_missing_key_or_lockpick");
+  fnMobMissingLockpick      = getSymbolIndex("player_mob_missing_lockpick");
+  fnMobTooFar               = getSymbolIndex("player_mob_too_far_away");
+
+  if(spellFxInstanceNames!=size_t(-1)) {
+    auto& spellInst = dat.getSymbolByIndex(spellFxInstanceNames);
+    fnSpellCast.resize(spellInst.strData.size());
+    for(size_t i=0; i<fnSpellCast.size(); ++i) {
+      char str[256]={};
+      std::snprintf(str,sizeof(str),"Spell_Cast_%s",spellInst.getString(i).c_str());
+      fnSpellCast[i] = getSymbolIndex(str);
+      }
+    }
+
   if(owner.version().game==2){
     auto& currency = dat.getSymbolByName("TRADE_CURRENCY_INSTANCE");
     itMi_Gold      = dat.getSymbolIndexByName(currency.getString(0).c_str());
@@ -438,6 +464,10 @@ void GameScript::initDialogs() {
     vm.initializeInstance(h, i, Daedalus::IC_Info);
     ++count;
     });
+
+  dialogsByNpc.clear();
+  for(size_t i=0; i<dialogsInfo.size(); ++i)
+    dialogsByNpc[size_t(dialogsInfo[i].npc)].push_back(i);
   }
 
 void GameScript::loadDialogOU() {
@@ -481,7 +511,7 @@ void GameScript::initializeInstance(Daedalus::GEngineClasses::C_Npc &n, size_t i
 
   if(n.daily_routine!=0) {
     ScopeVar self(vm,vm.globalSelf(),&n,Daedalus::IC_Npc);
-    vm.runFunctionBySymIndex(n.daily_routine);
+    runFunction(size_t(n.daily_routine));
     }
   }
 
@@ -495,9 +525,17 @@ void GameScript::clearReferences(Daedalus::GEngineClasses::Instance &ptr) {
 
 void GameScript::saveQuests(Serialize &fout) {
   quests.save(fout);
-  fout.write(uint32_t(dlgKnownInfos.size()));
+
+  std::vector<std::pair<uint32_t,uint32_t>> known;
   for(auto& i:dlgKnownInfos)
-    fout.write(uint32_t(i.first),uint32_t(i.second));
+    for(size_t r=0; r<i.second.size(); ++r)
+      if(i.second[r])
+        known.emplace_back(uint32_t(i.first),uint32_t(r));
+  std::sort(known.begin(),known.end());
+
+  fout.write(uint32_t(known.size()));
+  for(auto& i:known)
+    fout.write(i.first,i.second);
 
   fout.write(gilAttitudes);
   }
@@ -509,7 +547,7 @@ void GameScript::loadQuests(Serialize& fin) {
   for(size_t i=0;i<sz;++i){
     uint32_t f=0,s=0;
     fin.read(f,s);
-    dlgKnownInfos.insert(std::make_pair(f,s));
+    setNpcInfoKnown(f,s);
     }
 
   fin.read(gilAttitudes);
@@ -709,6 +747,9 @@ void GameScript::storeItem(Item *itm) {
   }
 
 Daedalus::PARSymbol &GameScript::getSymbol(std::string_view s) {
+  auto id = getSymbolIndex(s);
+  if(id!=size_t(-1))
+    return vm.getDATFile().getSymbolByIndex(id);
   char buf[256] = {};
   std::snprintf(buf,sizeof(buf),"%.*s",int(s.size()),s.data());
   return vm.getDATFile().getSymbolByName(buf);
@@ -719,9 +760,15 @@ Daedalus::PARSymbol &GameScript::getSymbol(const size_t s) {
   }
 
 size_t GameScript::getSymbolIndex(std::string_view s) {
+  auto it = symbolIndex.find(s);
+  if(it!=symbolIndex.end())
+    return it->second;
+  // symbol table is immutable after load: cache misses as well
   char buf[256] = {};
   std::snprintf(buf,sizeof(buf),"%.*s",int(s.size()),s.data());
-  return vm.getDATFile().getSymbolIndexByName(buf);
+  auto id = vm.getDATFile().getSymbolIndexByName(buf);
+  symbolIndex.emplace(std::string(s),id);
+  return id;
   }
 
 size_t GameScript::getSymbolCount() const {
@@ -761,18 +808,12 @@ std::vector<GameScript::DlgChoise> GameScript::dialogChoises(Daedalus::GEngineCl
   ScopeVar self (vm, vm.globalSelf(),  hnpc,   Daedalus::IC_Npc);
   ScopeVar other(vm, vm.globalOther(), player, Daedalus::IC_Npc);
 
-  std::vector<Daedalus::GEngineClasses::C_Info*> hDialog;
-  for(auto& info : dialogsInfo) {
-    if(info.npc==int32_t(npc.instanceSymbol)) {
-      hDialog.push_back(&info);
-      }
-    }
-
+  auto&                  hDialog = dialogsOf(npc);
   std::vector<DlgChoise> choise;
 
   for(int important=includeImp ? 1 : 0;important>=0;--important){
-    for(auto& i:hDialog) {
-      const Daedalus::GEngineClasses::C_Info& info = *i;
+    for(auto id:hDialog) {
+      Daedalus::GEngineClasses::C_Info& info = dialogsInfo[id];
       if(info.important!=important)
         continue;
       bool npcKnowsInfo = doesNpcKnowInfo(pl,info.instanceSymbol);
@@ -790,16 +831,13 @@ std::vector<GameScript::DlgChoise> GameScript::dialogChoises(Daedalus::GEngineCl
           continue;
         }
 
-      bool valid=true;
-      if(info.condition)
-        valid = runFunction(info.condition)!=0;
-      if(!valid)
+      if(!checkDialogCondition(id))
         continue;
 
       DlgChoise ch;
       ch.title    = info.description.c_str();
       ch.scriptFn = info.information;
-      ch.handle   = i;
+      ch.handle   = &info;
       ch.isTrade  = info.trade!=0;
       ch.sort     = info.nr;
       choise.emplace_back(std::move(ch));
@@ -860,86 +898,76 @@ void GameScript::exec(const GameScript::DlgChoise &dlg,Npc& player, Npc& npc) {
   }
 
 int GameScript::printCannotUseError(Npc& npc, int32_t atr, int32_t nValue) {
-  auto id = vm.getDATFile().getSymbolIndexByName("G_CanNotUse");
-  if(id==size_t(-1))
+  if(!fnCanNotUse.isValid())
     return 0;
   vm.pushInt(npc.isPlayer() ? 1 : 0);
   vm.pushInt(atr);
   vm.pushInt(nValue);
   ScopeVar self(vm, vm.globalSelf(), npc.handle(), Daedalus::IC_Npc);
-  return runFunction(id);
+  return runFunction(fnCanNotUse.ptr);
   }
 
 int GameScript::printCannotCastError(Npc &npc, int32_t plM, int32_t itM) {
-  auto id = vm.getDATFile().getSymbolIndexByName("G_CanNotCast");
-  if(id==size_t(-1))
+  if(!fnCanNotCast.isValid())
     return 0;
   vm.pushInt(npc.isPlayer() ? 1 : 0);
   vm.pushInt(itM);
   vm.pushInt(plM);
   ScopeVar self(vm, vm.globalSelf(), npc.handle(), Daedalus::IC_Npc);
-  return runFunction(id);
+  return runFunction(fnCanNotCast.ptr);
   }
 
 int GameScript::printCannotBuyError(Npc &npc) {
-  auto id = vm.getDATFile().getSymbolIndexByName("player_trade_not_enough_gold");
-  if(id==size_t(-1))
+  if(!fnTradeNotEnoughGold.isValid())
     return 0;
   ScopeVar self(vm, vm.globalSelf(), npc.handle(), Daedalus::IC_Npc);
-  return runFunction(id);
+  return runFunction(fnTradeNotEnoughGold.ptr);
   }
 
 int GameScript::printMobMissingItem(Npc &npc) {
-  auto id = vm.getDATFile().getSymbolIndexByName("player_mob_missing_item");
-  if(id==size_t(-1))
+  if(!fnMobMissingItem.isValid())
     return 0;
   ScopeVar self(vm, vm.globalSelf(), npc.handle(), Daedalus::IC_Npc);
-  return runFunction(id);
+  return runFunction(fnMobMissingItem.ptr);
   }
 
 int GameScript::printMobMissingKey(Npc& npc) {
-  auto id = vm.getDATFile().getSymbolIndexByName("player_mob_missing_key");
-  if(id==size_t(-1))
+  if(!fnMobMissingKey.isValid())
     return 0;
   ScopeVar self(vm, vm.globalSelf(), npc.handle(), Daedalus::IC_Npc);
-  return runFunction(id);
+  return runFunction(fnMobMissingKey.ptr);
   }
 
 int GameScript::printMobAnotherIsUsing(Npc &npc) {
-  auto id = vm.getDATFile().getSymbolIndexByName("player_mob_another_is_using");
-  if(id==size_t(-1))
+  if(!fnMobAnotherIsUsing.isValid())
     return 0;
   ScopeVar self(vm, vm.globalSelf(), npc.handle(), Daedalus::IC_Npc);
-  return runFunction(id);
+  return runFunction(fnMobAnotherIsUsing.ptr);
   }
 
 int GameScript::printMobMissingKeyOrLockpick(Npc& npc) {
-  auto id = vm.getDATFile().getSymbolIndexByName("player_mob_missing_key_or_lockpick");
-  if(id==size_t(-1))
+  if(!fnMobMissingKeyOrLockpick.isValid())
     return 0;
   ScopeVar self(vm, vm.globalSelf(), npc.handle(), Daedalus::IC_Npc);
-  return runFunction(id);
+  return runFunction(fnMobMissingKeyOrLockpick.ptr);
   }
 
 int GameScript::printMobMissingLockpick(Npc& npc) {
-  auto id = vm.getDATFile().getSymbolIndexByName("player_mob_missing_lockpick");
-  if(id==size_t(-1))
+  if(!fnMobMissingLockpick.isValid())
     return 0;
   ScopeVar self(vm, vm.globalSelf(), npc.handle(), Daedalus::IC_Npc);
-  return runFunction(id);
+  return runFunction(fnMobMissingLockpick.ptr);
   }
 
 int GameScript::printMobTooFar(Npc& npc) {
-  auto id = vm.getDATFile().getSymbolIndexByName("player_mob_too_far_away");
-  if(id==size_t(-1))
+  if(!fnMobTooFar.isValid())
     return 0;
   ScopeVar self(vm, vm.globalSelf(), npc.handle(), Daedalus::IC_Npc);
-  return runFunction(id);
+  return runFunction(fnMobTooFar.ptr);
   }
 
 int GameScript::invokeState(Daedalus::GEngineClasses::C_Npc* hnpc, Daedalus::GEngineClasses::C_Npc* oth, const char *name) {
-  auto& dat = vm.getDATFile();
-  auto  id  = dat.getSymbolIndexByName(name);
+  auto id = getSymbolIndex(name);
   if(id==size_t(-1))
     return 0;
 
@@ -986,27 +1014,22 @@ int GameScript::invokeItem(Npc *npc, ScriptFn fn) {
   }
 
 int GameScript::invokeMana(Npc &npc, Npc* target, Item &) {
-  auto& dat = vm.getDATFile();
-  auto fn   = dat.getSymbolIndexByName("Spell_ProcessMana");
-  if(fn==size_t(-1))
+  if(!fnProcessMana.isValid())
     return SpellCode::SPL_SENDSTOP;
 
   ScopeVar self (vm, vm.globalSelf(),  npc);
   ScopeVar other(vm, vm.globalOther(), target);
 
   vm.pushInt(npc.attribute(ATR_MANA));
-  return runFunction(fn);
+  return runFunction(fnProcessMana.ptr);
   }
 
 int GameScript::invokeSpell(Npc &npc, Npc* target, Item &it) {
-  auto& spellInst = vm.getDATFile().getSymbolByIndex(spellFxInstanceNames);
-  auto& tag       = spellInst.getString(size_t(it.spellId()));
-  char  str[256]={};
-  std::snprintf(str,sizeof(str),"Spell_Cast_%s",tag.c_str());
-
-  auto& dat = vm.getDATFile();
-  auto  fn  = dat.getSymbolIndexByName(str);
-  if(fn==size_t(-1))
+  const size_t splId = size_t(it.spellId());
+  if(splId>=fnSpellCast.size())
+    return 0;
+  auto fn = fnSpellCast[splId];
+  if(!fn.isValid())
     return 0;
 
   int32_t splLevel = 0;
@@ -1015,56 +1038,53 @@ int GameScript::invokeSpell(Npc &npc, Npc* target, Item &it) {
   ScopeVar other(vm, vm.globalOther(), target);
   try {
     vm.pushInt(splLevel);
-    return runFunction(fn);
+    return runFunction(fn.ptr);
     }
   catch(...){
-    Log::d("unable to call spell-script: \"",str,"\'");
+    Log::d("unable to call spell-script: \"",getSymbol(fn.ptr).name,"\'");
     return 0;
     }
   }
 
 int GameScript::invokeCond(Npc& npc, std::string_view func) {
-  auto fn = getSymbolIndex(func);
-  if(fn==size_t(-1)) {
+  return invokeCond(npc,ScriptFn(getSymbolIndex(func)));
+  }
+
+int GameScript::invokeCond(Npc& npc, ScriptFn fn) {
+  if(!fn.isValid()) {
     Gothic::inst().onPrint("MOBSI::conditionFunc is not invalid");
     return 1;
     }
   ScopeVar self(vm, vm.globalSelf(),  npc);
-  return runFunction(fn);
+  return runFunction(fn.ptr);
   }
 
 void GameScript::invokePickLock(Npc& npc, int bSuccess, int bBrokenOpen) {
-  auto& dat = vm.getDATFile();
-  auto fn   = dat.getSymbolIndexByName("G_PickLock");
-  if(fn==size_t(-1))
+  if(!fnPickLock.isValid())
     return;
   ScopeVar self(vm, vm.globalSelf(),  npc);
   vm.pushInt(bSuccess);
   vm.pushInt(bBrokenOpen);
-  runFunction(fn);
+  runFunction(fnPickLock.ptr);
   }
 
 CollideMask GameScript::canNpcCollideWithSpell(Npc& npc, Npc* shooter, int32_t spellId) {
-  auto& dat = vm.getDATFile();
-  auto fn   = dat.getSymbolIndexByName("C_CanNpcCollideWithSpell");
-  if(fn==size_t(-1))
+  if(!fnCanNpcCollideWithSpell.isValid())
     return COLL_DOEVERYTHING;
 
   ScopeVar self (vm, vm.globalSelf(),  npc);
   ScopeVar other(vm, vm.globalOther(), shooter);
   vm.pushInt(spellId);
-  int v = runFunction(fn);
+  int v = runFunction(fnCanNpcCollideWithSpell.ptr);
   return CollideMask(v);
   }
 
 int GameScript::playerHotKeyScreenMap(Npc& pl) {
-  auto& dat = vm.getDATFile();
-  auto fn   = dat.getSymbolIndexByName("player_hotkey_screen_map");
-  if(fn==size_t(-1))
+  if(!fnHotkeyScreenMap.isValid())
     return -1;
 
   ScopeVar self(vm, vm.globalSelf(), pl);
-  int map = runFunction(fn);
+  int map = runFunction(fnHotkeyScreenMap.ptr);
   if(map>=0)
     pl.useItem(size_t(map));
   return map;
@@ -1151,11 +1171,10 @@ uint32_t GameScript::messageTime(const Daedalus::ZString& id) const {
   }
 
 int GameScript::printNothingToGet() {
-  auto id = vm.getDATFile().getSymbolIndexByName("player_plunder_is_empty");
-  if(id==size_t(-1))
+  if(!fnPlunderIsEmpty.isValid())
     return 0;
   ScopeVar self(vm, vm.globalSelf(), owner.player());
-  return runFunction(id);
+  return runFunction(fnPlunderIsEmpty.ptr);
   }
 
 void GameScript::useInteractive(Daedalus::GEngineClasses::C_Npc* hnpc,const std::string& func) {
@@ -1172,6 +1191,19 @@ void GameScript::useInteractive(Daedalus::GEngineClasses::C_Npc* hnpc,const std:
     }
   }
 
+void GameScript::useInteractive(Daedalus::GEngineClasses::C_Npc* hnpc, ScriptFn fn) {
+  if(!fn.isValid())
+    return;
+
+  ScopeVar self(vm,vm.globalSelf(),hnpc,Daedalus::IC_Npc);
+  try {
+    runFunction(fn.ptr);
+    }
+  catch (...) {
+    Log::i("unable to use interactive [",getSymbol(fn.ptr).name,"]");
+    }
+  }
+
 Attitude GameScript::guildAttitude(const Npc &p0, const Npc &p1) const {
   auto selfG = std::min<size_t>(gilCount-1,p0.guild());
   auto npcG  = std::min<size_t>(gilCount-1,p1.guild());
@@ -1244,15 +1276,11 @@ bool GameScript::searchScheme(std::string_view sc, std::string_view listName) {
   }
 
 bool GameScript::hasSymbolName(std::string_view s) {
-  char buf[256] = {};
-  std::snprintf(buf,sizeof(buf),"%.*s",int(s.size()),s.data());
-  return vm.getDATFile().hasSymbolName(buf);
+  return getSymbolIndex(s)!=size_t(-1);
   }
 
 int32_t GameScript::runFunction(std::string_view s) {
-  char buf[256] = {};
-  std::snprintf(buf,sizeof(buf),"%.*s",int(s.size()),s.data());
-  auto id = vm.getDATFile().getSymbolIndexByName(buf);
+  auto id = getSymbolIndex(s);
   if(id==size_t(-1))
     throw std::runtime_error("script bad call");
   return runFunction(id);
@@ -1263,10 +1291,33 @@ int32_t GameScript::runFunction(const size_t fid) {
   auto&       sym  = dat.getSymbolByIndex(fid);
   const char* call = sym.name.c_str();(void)call; //for debuging
 
-  int32_t ret = vm.runFunctionBySymIndex(fid);
+  if(!profiler.isEnabled())
+    return vm.runFunctionBySymIndex(fid);
+
+  profiler.enter(fid);
+  int32_t ret = 0;
+  try {
+    ret = vm.runFunctionBySymIndex(fid);
+    }
+  catch(...) {
+    profiler.leave();
+    throw;
+    }
+  profiler.leave();
   return ret;
   }
 
+auto GameScript::profileHotList(size_t count) const -> std::vector<ScriptProfiler::Stat> {
+  return profiler.hotList(count);
+  }
+
+bool GameScript::dumpProfile(std::string_view file) {
+  auto& dat = vm.getDATFile();
+  return profiler.dump(file,[&dat](size_t fn) -> std::string_view {
+    return dat.getSymbolByIndex(fn).name;
+    });
+  }
+
 uint64_t GameScript::tickCount() const {
   return owner.tickCount();
   }
@@ -2419,15 +2470,14 @@ void GameScript::npc_checkinfo(Daedalus::DaedalusVM &vm) {
   auto& pl   = *(hpl);
   auto& npc  = *(n->handle());
 
-  for(auto& info:dialogsInfo) {
-    if(info.npc!=int32_t(npc.instanceSymbol) || info.important!=imp)
+  for(auto id:dialogsOf(npc)) {
+    auto& info = dialogsInfo[id];
+    if(info.important!=imp)
       continue;
     bool npcKnowsInfo = doesNpcKnowInfo(pl,info.instanceSymbol);
     if(npcKnowsInfo && !info.permanent)
       continue;
-    bool valid=false;
-    if(info.condition)
-      valid = runFunction(info.condition)!=0;
+    bool valid = info.condition!=0 && checkDialogCondition(id);
     if(valid) {
       vm.setReturn(1);
       return;
@@ -3349,13 +3399,36 @@ void GameScript::sort(std::vector<GameScript::DlgChoise> &dlg) {
   }
 
 void GameScript::setNpcInfoKnown(const Daedalus::GEngineClasses::C_Npc& npc, const Daedalus::GEngineClasses::C_Info &info) {
-  auto id = std::make_pair(npc.instanceSymbol,info.instanceSymbol);
-  dlgKnownInfos.insert(id);
+  setNpcInfoKnown(npc.instanceSymbol,info.instanceSymbol);
+  }
+
+void GameScript::setNpcInfoKnown(size_t npcInstance, size_t infoInstance) {
+  auto& known = dlgKnownInfos[npcInstance];
+  if(known.size()<=infoInstance)
+    known.resize(std::max(infoInstance+1,getSymbolCount()));
+  known[infoInstance] = true;
   }
 
 bool GameScript::doesNpcKnowInfo(const Daedalus::GEngineClasses::C_Npc& npc, size_t infoInstance) const {
-  auto id = std::make_pair(npc.instanceSymbol,infoInstance);
-  return dlgKnownInfos.find(id)!=dlgKnownInfos.end();
+  auto it = dlgKnownInfos.find(npc.instanceSymbol);
+  if(it==dlgKnownInfos.end() || it->second.size()<=infoInstance)
+    return false;
+  return it->second[infoInstance];
+  }
+
+bool GameScript::checkDialogCondition(size_t dlgId) {
+  auto& info = dialogsInfo[dlgId];
+  if(!info.condition)
+    return true;
+  return runFunction(info.condition)!=0;
+  }
+
+const std::vector<size_t>& GameScript::dialogsOf(const Daedalus::GEngineClasses::C_Npc& npc) const {
+  static const std::vector<size_t> empty;
+  auto it = dialogsByNpc.find(npc.instanceSymbol);
+  if(it==dialogsByNpc.end())
+    return empty;
+  return it->second;
   }
 
 
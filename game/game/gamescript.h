@@ -18,6 +18,7 @@
 #include "game/constants.h"
 #include "game/aistate.h"
 #include "game/questlog.h"
+#include "game/scriptprofiler.h"
 #include "graphics/pfx/pfxobjects.h"
 #include "ui/documentmenu.h"
 
@@ -62,6 +63,11 @@ class GameScript final {
     int32_t      runFunction  (std::string_view fname);
     int32_t      runFunction  (const size_t fid);
 
+    void         setProfiling(bool e) { profiler.setEnabled(e); }
+    bool         isProfiling() const  { return profiler.isEnabled(); }
+    auto         profileHotList(size_t count) const -> std::vector<ScriptProfiler::Stat>;
+    bool         dumpProfile(std::string_view file);
+
     void         initDialogs ();
     void         loadDialogOU();
 
@@ -131,6 +137,7 @@ class GameScript final {
     int  invokeMana (Npc& npc, Npc* target, Item&  fn);
     int  invokeSpell(Npc& npc, Npc *target, Item&  fn);
     int  invokeCond (Npc& npc, std::string_view func);
+    int  invokeCond (Npc& npc, ScriptFn fn);
     void invokePickLock(Npc& npc, int bSuccess, int bBrokenOpen);
     auto canNpcCollideWithSpell(Npc& npc, Npc* shooter, int32_t spellId) -> CollideMask;
 
@@ -150,6 +157,7 @@ class GameScript final {
     int      printNothingToGet();
     float    tradeValueMultiplier() const { return tradeValMult; }
     void     useInteractive(Daedalus::GEngineClasses::C_Npc *hnpc, const std::string &func);
+    void     useInteractive(Daedalus::GEngineClasses::C_Npc *hnpc, ScriptFn fn);
     Attitude guildAttitude(const Npc& p0,const Npc& p1) const;
     Attitude personAttitude(const Npc& p0,const Npc& p1) const;
 
@@ -404,13 +412,21 @@ class GameScript final {
 
     void sort(std::vector<DlgChoise>& dlg);
     void setNpcInfoKnown(const Daedalus::GEngineClasses::C_Npc& npc, const Daedalus::GEngineClasses::C_Info& info);
+    void setNpcInfoKnown(size_t npcInstance, size_t infoInstance);
     bool doesNpcKnowInfo(const Daedalus::GEngineClasses::C_Npc& npc, size_t infoInstance) const;
+    bool checkDialogCondition(size_t dlgId);
+    auto dialogsOf(const Daedalus::GEngineClasses::C_Npc& npc) const -> const std::vector<size_t>&;
 
     void saveSym(Serialize& fout,const Daedalus::PARSymbol& s);
 
     void onWldInstanceRemoved(const Daedalus::GEngineClasses::Instance* obj);
     void makeCurrent(Item* w);
 
+    struct SymbolNameHash {
+      using is_transparent = void;
+      size_t operator()(std::string_view s) const { return std::hash<std::string_view>()(s); }
+      };
+
     GameSession&                                                owner;
     Daedalus::DaedalusVM                                        vm;
     std::mt19937                                                randGen;
@@ -421,11 +437,14 @@ class GameScript final {
     std::unique_ptr<SvmDefinitions>                             svm;
     uint64_t                                                    svmBarrier=0;
 
-    std::set<std::pair<size_t,size_t>>                          dlgKnownInfos;
+    std::unordered_map<size_t,std::vector<bool>>                dlgKnownInfos; // npc instance -> known info symbols
     std::vector<Daedalus::GEngineClasses::C_Info>               dialogsInfo;
+    std::unordered_map<size_t,std::vector<size_t>>              dialogsByNpc;  // npc instance -> dialogsInfo index
     std::unique_ptr<ZenLoad::zCCSLib>                           dialogs;
     std::unordered_map<size_t,AiState>                          aiStates;
     std::unique_ptr<AiOuputPipe>                                aiDefaultPipe;
+    std::unordered_map<std::string,size_t,SymbolNameHash,std::equal_to<>> symbolIndex;
+    ScriptProfiler                                              profiler;
 
     QuestLog                                                    quests;
     size_t                                                      itMi_Gold=0;
@@ -445,6 +464,14 @@ class GameScript final {
     size_t                                                      ZS_Attack=0;
     size_t                                                      ZS_MM_Attack=0;
 
+    // engine entry points, resolved once in initCommon
+    ScriptFn                                                    fnCanNotUse, fnCanNotCast, fnPickLock;
+    ScriptFn                                                    fnProcessMana, fnCanNpcCollideWithSpell;
+    ScriptFn                                                    fnTradeNotEnoughGold, fnPlunderIsEmpty, fnHotkeyScreenMap;
+    ScriptFn                                                    fnMobMissingItem, fnMobMissingKey, fnMobAnotherIsUsing;
+    ScriptFn                                                    fnMobMissingKeyOrLockpick, fnMobMissingLockpick, fnMobTooFar;
+    std::vector<ScriptFn>                                       fnSpellCast; // Spell_Cast_<tag>, index by spellId
+
     Daedalus::GEngineClasses::C_Focus                           cFocusNorm,cFocusMele,cFocusRange,cFocusMage;
     Daedalus::GEngineClasses::C_GilValues                       cGuildVal;
   };
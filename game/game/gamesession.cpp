@@ -11,6 +11,8 @@
 #include "world/world.h"
 #include "sound/soundfx.h"
 #include "serialize.h"
+#include "utils/frameprofiler.h"
+#include "utils/memoryreport.h"
 #include "camera.h"
 #include "gothic.h"
 
@@ -261,6 +263,7 @@ void GameSession::setTime(gtime t) {
   }
 
 void GameSession::tick(uint64_t dt) {
+  FrameProfiler::Zone zone("GameSession::tick");
   wrld->scaleTime(dt);
   ticks+=dt;
 
@@ -376,6 +379,15 @@ void GameSession::updateAnimation(uint64_t dt) {
     wrld->updateAnimation(dt);
   }
 
+void GameSession::memoryUsage(MemoryReport& rep) const {
+  if(wrld)
+    wrld->memoryUsage(rep);
+  size_t bytes = 0;
+  for(auto& i:visitedWorlds)
+    bytes += i.storage.capacity();
+  rep.add("world states",visitedWorlds.size(),bytes);
+  }
+
 std::vector<GameScript::DlgChoise> GameSession::updateDialog(const GameScript::DlgChoise &dlg, Npc& player, Npc& npc) {
   return vm->updateDialog(dlg,player,npc);
   }
@@ -22,6 +22,7 @@ class VisualFx;
 class WorldStateStorage;
 class VersionInfo;
 class GthFont;
+class MemoryReport;
 
 class GameSession final {
   public:
@@ -61,6 +62,7 @@ class GameSession final {
     uint64_t     tickCount() const { return ticks; }
 
     void         updateAnimation(uint64_t dt);
+    void         memoryUsage(MemoryReport& rep) const;
 
     auto         updateDialog(const GameScript::DlgChoise &dlg, Npc &player, Npc &npc) -> std::vector<GameScript::DlgChoise>;
     void         dialogExec(const GameScript::DlgChoise &dlg, Npc &player, Npc &npc);
@@ -99,6 +99,8 @@ void Inventory::implLoad(Npc* owner, World& world, Serialize &s) {
   s.read(sz);
   for(size_t i=0;i<sz;++i)
     items.emplace_back(std::make_unique<Item>(world,s,Item::T_Inventory));
+  sorted = false;
+  rebuildIndex();
 
   s.read(sz);
   mdlSlots.resize(sz);
@@ -192,16 +194,14 @@ Inventory::Iterator Inventory::iterator(IteratorType t) const {
   }
 
 int32_t Inventory::priceOf(size_t cls) const {
-  for(auto& i:items)
-    if(i->clsId()==cls)
-      return i->cost();
+  if(auto it = findByClass(cls))
+    return it->cost();
   return 0;
   }
 
 int32_t Inventory::sellPriceOf(size_t cls) const {
-  for(auto& i:items)
-    if(i->clsId()==cls)
-      return i->sellCost();
+  if(auto it = findByClass(cls))
+    return it->sellCost();
   return 0;
   }
 
@@ -213,9 +213,8 @@ size_t Inventory::goldCount() const {
   }
 
 size_t Inventory::itemCount(const size_t cls) const {
-  for(auto& i:items)
-    if(i->clsId()==cls)
-      return i->count();
+  if(auto it = findByClass(cls))
+    return it->count();
   return 0;
   }
 
@@ -223,15 +222,14 @@ Item* Inventory::addItem(std::unique_ptr<Item> &&p) {
   using namespace Daedalus::GEngineClasses;
   if(p==nullptr)
     return nullptr;
-  sorted=false;
 
   const auto cls = p->clsId();
   p->clearView();
   Item* it=findByClass(cls);
   if(it==nullptr) {
-    p->clearView();
-    items.emplace_back(std::move(p));
-    return items.back().get();
+    Item* ret = p.get();
+    insertItem(std::move(p));
+    return ret;
     } else {
     it->setCount(it->count()+p->count());
     it->handle().owner      = p->handle().owner;
@@ -252,15 +250,15 @@ Item* Inventory::addItem(size_t itemSymbol, size_t count, World &owner) {
   using namespace Daedalus::GEngineClasses;
   if(count<=0)
     return nullptr;
-  sorted=false;
 
   Item* it=findByClass(itemSymbol);
   if(it==nullptr) {
     try {
       std::unique_ptr<Item> ptr{new Item(owner,itemSymbol,Item::T_Inventory)};
       ptr->setCount(count);
-      items.emplace_back(std::move(ptr));
-      return items.back().get();
+      Item* ret = ptr.get();
+      insertItem(std::move(ptr));
+      return ret;
       }
     catch(const Daedalus::InvalidCall& call) {
       Log::e("[invalid call in VM, while initializing item: ",itemSymbol,"]");
@@ -305,41 +303,30 @@ void Inventory::delItem(Item *it, size_t count, Npc& owner) {
       } else {
       ++i;
       }
-  sorted=false;
-
-  for(size_t i=0;i<items.size();++i)
-    if(items[i]->clsId()==it->clsId()){
-      items.erase(items.begin()+int(i));
-      break;
-      }
+  takeItem(it);
   }
 
 void Inventory::trasfer(Inventory &to, Inventory &from, Npc* fromNpc, size_t itemSymbol, size_t count, World &wrld) {
-  for(size_t i=0;i<from.items.size();++i){
-    auto& it = *from.items[i];
-    if(it.clsId()!=itemSymbol)
-      continue;
-
-    from.sorted = false;
-    to.sorted   = false;
+  Item* pit = from.findByClass(itemSymbol);
+  if(pit==nullptr)
+    return;
 
-    if(count>it.count())
-      count=it.count();
+  auto& it = *pit;
+  if(count>it.count())
+    count=it.count();
 
-    if(it.count()==count) {
-      if(it.isEquiped()){
-        if(fromNpc==nullptr){
-          Log::e("Inventory: invalid transfer call");
-          return; // error
-          }
-        from.unequip(&it,*fromNpc);
+  if(it.count()==count) {
+    if(it.isEquiped()){
+      if(fromNpc==nullptr){
+        Log::e("Inventory: invalid transfer call");
+        return; // error
         }
-      to.addItem(std::move(from.items[i]));
-      from.items.erase(from.items.begin()+int(i));
-      } else {
-      it.setCount(it.count()-count);
-      to.addItem(itemSymbol,count,wrld);
+      from.unequip(&it,*fromNpc);
       }
+    to.addItem(from.takeItem(pit));
+    } else {
+    it.setCount(it.count()-count);
+    to.addItem(itemSymbol,count,wrld);
     }
   }
 
@@ -546,6 +533,7 @@ void Inventory::clear(GameScript&, Npc&, bool includeMissionItm) {
       used.emplace_back(std::move(i));
       }
   items = std::move(used); // Gothic don't clear items, which are in use
+  rebuildIndex();
   }
 
 void Inventory::clear(GameScript& vm, Interactive& owner, bool includeMissionItm) {
@@ -555,6 +543,7 @@ void Inventory::clear(GameScript& vm, Interactive& owner, bool includeMissionItm
       used.emplace_back(std::move(i));
       }
   items = std::move(used); // Gothic don't clear items, which are in use
+  rebuildIndex();
   }
 
 bool Inventory::hasMissionItems() const {
@@ -897,12 +886,51 @@ void Inventory::equipBestArmour(Npc &owner) {
   }
 
 Item *Inventory::findByClass(size_t cls) {
-  for(auto& i:items)
-    if(i->clsId()==cls)
-      return i.get();
+  auto i = byClass.find(cls);
+  if(i!=byClass.end())
+    return i->second;
   return nullptr;
   }
 
+const Item* Inventory::findByClass(size_t cls) const {
+  auto i = byClass.find(cls);
+  if(i!=byClass.end())
+    return i->second;
+  return nullptr;
+  }
+
+void Inventory::insertItem(std::unique_ptr<Item>&& p) {
+  byClass[p->clsId()] = p.get();
+  if(!sorted) {
+    items.emplace_back(std::move(p));
+    return;
+    }
+  // keep sorted view up to date, instead of full re-sort on next iteration
+  auto at = std::upper_bound(items.begin(),items.end(),p,[](const std::unique_ptr<Item>& l, const std::unique_ptr<Item>& r){
+    return less(*l,*r);
+    });
+  items.emplace(at,std::move(p));
+  }
+
+std::unique_ptr<Item> Inventory::takeItem(const Item* it) {
+  byClass.erase(it->clsId());
+  // erase preserves order of remaining items
+  for(size_t i=0;i<items.size();++i)
+    if(items[i].get()==it) {
+      auto ret = std::move(items[i]);
+      items.erase(items.begin()+int(i));
+      return ret;
+      }
+  return nullptr;
+  }
+
+void Inventory::rebuildIndex() {
+  byClass.clear();
+  byClass.reserve(items.size());
+  for(auto& i:items)
+    byClass[i->clsId()] = i.get();
+  }
+
 Item* Inventory::bestItem(Npc &owner, ItmFlags f) {
   Item* ret=nullptr;
   int   g  =-1;
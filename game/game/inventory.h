@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <memory>
+#include <unordered_map>
 #include <daedalus/DaedalusGameState.h>
 
 #include "game/constants.h"
@@ -132,6 +133,10 @@ class Inventory final {
     void   applyArmour (Item& it, Npc &owner, int32_t sgn);
 
     Item*  findByClass(size_t cls);
+    const Item* findByClass(size_t cls) const;
+    void   insertItem (std::unique_ptr<Item>&& p);
+    std::unique_ptr<Item> takeItem(const Item* it);
+    void   rebuildIndex();
     void   delItem    (Item* it, size_t count, Npc& owner);
     void   invalidateCond(Item*& slot,  Npc &owner);
 
@@ -149,6 +154,8 @@ class Inventory final {
 
     mutable std::vector<std::unique_ptr<Item>> items;
     mutable bool                               sorted=false;
+    // class -> item; Item is heap-allocated, so pointers survive sorting
+    std::unordered_map<size_t,Item*>           byClass;
 
     uint32_t                           indexOf(const Item* it) const;
     Item*                              readPtr(Serialize& fin);
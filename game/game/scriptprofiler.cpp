@@ -0,0 +1,116 @@
+#include "scriptprofiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+
+ScriptProfiler::ScriptProfiler() {
+  nodes.resize(1);
+  }
+
+void ScriptProfiler::setEnabled(bool e) {
+  if(enabled==e)
+    return;
+  enabled = e;
+  if(enabled) {
+    nodes.resize(1);
+    nodes[0] = Node();
+    edges.clear();
+    }
+  stack.clear();
+  }
+
+void ScriptProfiler::enter(size_t fn) {
+  const size_t   parent = stack.empty() ? 0 : stack.back().node;
+  const uint64_t key    = (uint64_t(parent)<<32) | uint32_t(fn);
+
+  auto it = edges.find(key);
+  if(it==edges.end()) {
+    Node n;
+    n.fn     = fn;
+    n.parent = parent;
+    nodes.push_back(n);
+    it = edges.emplace(key,nodes.size()-1).first;
+    }
+
+  Frame f;
+  f.node  = it->second;
+  f.start = now();
+  stack.push_back(f);
+  }
+
+void ScriptProfiler::leave() {
+  if(stack.empty())
+    return;
+  const Frame    f  = stack.back();
+  const uint64_t dt = now()-f.start;
+  stack.pop_back();
+
+  auto& n = nodes[f.node];
+  n.calls++;
+  n.incl += dt;
+  n.excl += dt>f.child ? dt-f.child : 0;
+  if(!stack.empty())
+    stack.back().child += dt;
+  }
+
+auto ScriptProfiler::hotList(size_t count) const -> std::vector<Stat> {
+  std::unordered_map<size_t,Stat> fn;
+  for(size_t i=1; i<nodes.size(); ++i) {
+    auto& n = nodes[i];
+    auto& s = fn[n.fn];
+    s.fn         = n.fn;
+    s.calls     += n.calls;
+    s.exclusive += n.excl;
+
+    // recursive calls are already accounted by the outermost frame
+    bool recursive = false;
+    for(size_t p=n.parent; p!=0; p=nodes[p].parent)
+      if(nodes[p].fn==n.fn) {
+        recursive = true;
+        break;
+        }
+    if(!recursive)
+      s.inclusive += n.incl;
+    }
+
+  std::vector<Stat> ret;
+  ret.reserve(fn.size());
+  for(auto& i:fn)
+    ret.push_back(i.second);
+  std::sort(ret.begin(),ret.end(),[](const Stat& l, const Stat& r){
+    return l.exclusive>r.exclusive;
+    });
+  if(ret.size()>count)
+    ret.resize(count);
+  return ret;
+  }
+
+bool ScriptProfiler::dump(std::string_view file, const std::function<std::string_view(size_t)>& name) const {
+  std::ofstream out{std::string(file)};
+  if(!out)
+    return false;
+
+  std::vector<size_t> path;
+  for(size_t i=1; i<nodes.size(); ++i) {
+    auto& n = nodes[i];
+    if(n.calls==0)
+      continue;
+    path.clear();
+    for(size_t p=i; p!=0; p=nodes[p].parent)
+      path.push_back(nodes[p].fn);
+    for(size_t r=path.size(); r>0; --r) {
+      out << name(path[r-1]);
+      if(r>1)
+        out << ';';
+      }
+    out << ' ' << n.excl/1000 << '\n';
+    }
+  return bool(out);
+  }
+
+uint64_t ScriptProfiler::now() {
+  auto t = std::chrono::steady_clock::now().time_since_epoch();
+  return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(t).count());
+  }
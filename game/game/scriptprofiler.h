@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class ScriptProfiler final {
+  public:
+    ScriptProfiler();
+
+    struct Stat {
+      size_t   fn        = 0;
+      uint64_t calls     = 0;
+      uint64_t inclusive = 0; // ns
+      uint64_t exclusive = 0; // ns
+      };
+
+    void setEnabled(bool e);
+    bool isEnabled() const { return enabled; }
+
+    void enter(size_t fn);
+    void leave();
+
+    // per-function totals, sorted by exclusive time
+    auto hotList(size_t count) const -> std::vector<Stat>;
+    // collapsed stacks, as consumed by flamegraph.pl/speedscope; time in microseconds
+    bool dump(std::string_view file, const std::function<std::string_view(size_t)>& name) const;
+
+  private:
+    struct Node {
+      size_t   fn     = 0;
+      size_t   parent = 0;
+      uint64_t calls  = 0;
+      uint64_t incl   = 0;
+      uint64_t excl   = 0;
+      };
+
+    struct Frame {
+      size_t   node  = 0;
+      uint64_t start = 0;
+      uint64_t child = 0;
+      };
+
+    static uint64_t now();
+
+    bool                                enabled = false;
+    std::vector<Node>                   nodes;  // call tree, [0] is root
+    std::unordered_map<uint64_t,size_t> edges;  // parent node + function -> node
+    std::vector<Frame>                  stack;
+  };
@@ -6,17 +6,78 @@
 
 #include "game/definitions/musicdefinitions.h"
 #include "dmusic/mixer.h"
+#include "sound/musiccache.h"
+#include "commandline.h"
 #include "resources.h"
 
 using namespace Tempest;
 
 struct GameMusic::MusicProducer : Tempest::SoundProducer {
   MusicProducer():SoundProducer(44100,2){
+    if(CommandLine::inst().doMusicCache())
+      cache.reset(new MusicCache());
     }
 
+  // pre-rendered music, see MusicCache
+  struct Stream {
+    MusicCache::Track pcm;
+    size_t            pos = 0;
+    float             vol = 1.f;
+
+    void render(int16_t* out, size_t n, float volume) {
+      auto&       v   = *pcm;
+      const float mul = vol*volume;
+      for(size_t i=0; i<n*2; ++i) {
+        float s = float(v[pos])*mul;
+        out[i]  = int16_t(std::min(std::max(s,-32768.f),32767.f));
+        pos     = (pos+1)%v.size();
+        }
+      }
+    };
+
   void renderSound(int16_t* out,size_t n) override {
     updateTheme();
-    mix.mix(out,n);
+    if(stopStream.exchange(false)) {
+      stream     = Stream();
+      prev       = Stream();
+      fadeRemain = 0;
+      }
+
+    if(stream.pcm!=nullptr)
+      stream.render(out,n,volume.load()); else
+      mix.mix(out,n);
+
+    if(fadeRemain==0)
+      return;
+
+    // crossfade previous music out
+    tmp.resize(n*2);
+    if(prev.pcm!=nullptr)
+      prev.render(tmp.data(),n,volume.load()); else
+      mix.mix(tmp.data(),n);
+
+    for(size_t i=0; i<n && fadeRemain>0; ++i) {
+      float k = float(fadeRemain)/float(FadeLength);
+      for(size_t c=0; c<2; ++c)
+        out[i*2+c] = int16_t(float(out[i*2+c])*(1.f-k) + float(tmp[i*2+c])*k);
+      --fadeRemain;
+      }
+
+    if(fadeRemain==0) {
+      if(prev.pcm==nullptr && stream.pcm!=nullptr)
+        mix.setMusic(Dx8::Music());
+      prev = Stream();
+      }
+    }
+
+  void startFade(Stream&& next) {
+    const bool live = (stream.pcm==nullptr);
+    if(live && next.pcm==nullptr)
+      return;
+    // previous stream, or live mixer, fades out in renderSound
+    prev       = std::move(stream);
+    stream     = std::move(next);
+    fadeRemain = FadeLength;
     }
 
   void updateTheme() {
@@ -42,6 +103,20 @@ struct GameMusic::MusicProducer : Tempest::SoundProducer {
 
     try {
       if(reloadTheme) {
+        MusicCache::Track track;
+        if(cache!=nullptr)
+          track = cache->find(theme.file.c_str());
+
+        if(track!=nullptr) {
+          Stream next;
+          next.pcm = track;
+          next.vol = theme.vol;
+          startFade(std::move(next));
+          currentTags = tags;
+          return;
+          }
+        startFade(Stream());
+
         Dx8::PatternList p = Resources::loadDxMusic(theme.file.c_str());
 
         Dx8::Music m;
@@ -67,6 +142,7 @@ struct GameMusic::MusicProducer : Tempest::SoundProducer {
         mix.setMusic(m,em);
         currentTags=tags;
         }
+      stream.vol = theme.vol;
       mix.setMusicVolume(theme.vol);
       }
     catch(std::runtime_error&) {
@@ -94,17 +170,29 @@ struct GameMusic::MusicProducer : Tempest::SoundProducer {
     enable.store(false);
     std::lock_guard<std::mutex> guard(pendingSync);
     mix.setMusic(Dx8::Music());
+    stopStream.store(true);
     }
 
   void setVolume(float v) {
     mix.setVolume(v);
+    volume.store(v);
     }
 
   bool isEnabled() const {
     return enable.load();
     }
 
+  enum {
+    FadeLength = 44100, // one second
+    };
+
   Dx8::Mixer                             mix;
+  std::unique_ptr<MusicCache>            cache;
+  Stream                                 stream, prev;
+  size_t                                 fadeRemain = 0;
+  std::vector<int16_t>                   tmp;
+  std::atomic<float>                     volume{1.f};
+  std::atomic_bool                       stopStream{false};
 
   std::mutex                             pendingSync;
   std::atomic_bool                       enable{true};
@@ -17,6 +17,7 @@
 
 #include "utils/fileutil.h"
 #include "utils/inifile.h"
+#include "utils/memoryreport.h"
 
 #include "commandline.h"
 
@@ -468,6 +469,17 @@ void Gothic::tick(uint64_t dt) {
 
   if(game)
     game->tick(dt);
+
+  if(CommandLine::inst().doMemoryLog()) {
+    memLogTime += dt;
+    if(memLogTime>=MemLogPeriod) {
+      memLogTime = 0;
+      MemoryReport rep;
+      memoryUsage(rep);
+      Tempest::Log::i("memory budget:");
+      rep.print([](std::string_view s){ Tempest::Log::i("  ",s); });
+      }
+    }
   }
 
 void Gothic::updateAnimation(uint64_t dt) {
@@ -475,6 +487,16 @@ void Gothic::updateAnimation(uint64_t dt) {
     game->updateAnimation(dt);
   }
 
+void Gothic::memoryUsage(MemoryReport& rep) {
+  Resources::memoryUsage(rep);
+  {
+  std::lock_guard<std::mutex> guard(syncSnd);
+  rep.add("sound fx",sndFxCache.size()+sndWavCache.size(),0);
+  }
+  if(game)
+    game->memoryUsage(rep);
+  }
+
 void Gothic::quickSave() {
   save("save_slot_0.sav","Quick save");
   }
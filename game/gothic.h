@@ -23,6 +23,7 @@ class VisualFxDefinitions;
 class ParticlesDefinitions;
 class MusicDefinitions;
 class IniFile;
+class MemoryReport;
 
 class Gothic final {
   public:
@@ -101,6 +102,7 @@ class Gothic final {
     void         tick(uint64_t dt);
 
     void         updateAnimation(uint64_t dt);
+    void         memoryUsage(MemoryReport& rep);
     void         quickSave();
     void         quickLoad();
     void         save(std::string_view slot, std::string_view usrName);
@@ -157,6 +159,10 @@ class Gothic final {
     static void debug(const ZenLoad::PackedSkeletalMesh& mesh, std::ostream& out);
 
   private:
+    enum {
+      MemLogPeriod = 60*1000, // ms
+      };
+
     VersionInfo                             vinfo;
     std::mt19937                            randGen;
     uint16_t                                pauseSum=0;
@@ -193,6 +199,7 @@ class Gothic final {
     std::vector<std::unique_ptr<DocumentMenu::Show>> documents;
     ChapterScreen::Show                     chapter;
     bool                                    pendingChapter=false;
+    uint64_t                                memLogTime=0;
 
     std::vector<ItmFlags>                   inventoryOrder;
 
@@ -5,6 +5,7 @@
 #include "frustrum.h"
 #include "visibleset.h"
 #include "utils/workers.h"
+#include "utils/frameprofiler.h"
 
 #include "graphics/objectsbucket.h"
 
@@ -258,6 +259,7 @@ VisibilityGroup::Token VisibilityGroup::get(Group g) {
   }
 
 void VisibilityGroup::pass(const Frustrum f[]) {
+  FrameProfiler::Zone zone("VisibilityGroup::pass");
   if(updateThree) {
     buildTree();
     updateThree = false;
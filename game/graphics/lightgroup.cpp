@@ -15,8 +15,7 @@
 using namespace Tempest;
 
 size_t LightGroup::LightBucket::alloc() {
-  for(auto& i:updated)
-    i = false;
+  invalidate();
   if(freeList.size()>0) {
     auto ret = freeList.back();
     freeList.pop_back();
@@ -28,8 +27,7 @@ size_t LightGroup::LightBucket::alloc() {
   }
 
 void LightGroup::LightBucket::free(size_t id) {
-  for(auto& i:updated)
-    i = false;
+  invalidate();
   if(id+1==data.size()) {
     data.pop_back();
     light.pop_back();
@@ -40,6 +38,77 @@ void LightGroup::LightBucket::free(size_t id) {
     }
   }
 
+void LightGroup::LightBucket::invalidate() {
+  for(auto& i:updated)
+    i = false;
+  }
+
+void LightGroup::LightBucket::markDirty(size_t id) {
+  for(auto& d:dirty) {
+    if(d.begin==d.end) {
+      d.begin = id;
+      d.end   = id+1;
+      } else {
+      d.begin = std::min(d.begin,id);
+      d.end   = std::max(d.end,  id+1);
+      }
+    }
+  }
+
+size_t LightGroup::LightBucket::upload(uint8_t fId) {
+  auto& device = Resources::device();
+  auto& d      = dirty[fId];
+
+  if(!updated[fId]) {
+    updated[fId] = true;
+    d            = DirtyRange();
+    if(ssbo[fId].byteSize()==data.size()*sizeof(data[0])) {
+      ssbo[fId].update(data);
+      } else {
+      ssbo[fId] = device.ssbo(BufferHeap::Upload,data);
+      ubo [fId].set(4,ssbo[fId]);
+      }
+    return data.size()*sizeof(data[0]);
+    }
+
+  if(d.begin==d.end)
+    return 0;
+  // only lights that have changed since this frame-slot was uploaded last time
+  const size_t begin = d.begin;
+  const size_t count = std::min(d.end,data.size())-begin;
+  d = DirtyRange();
+  if(count==0)
+    return 0;
+  ssbo[fId].update(data.data()+begin, begin*sizeof(data[0]), count*sizeof(data[0]));
+  return count*sizeof(data[0]);
+  }
+
+void LightGroup::LightBucket::cull(const Frustrum& fr, uint8_t fId) {
+  auto& device = Resources::device();
+
+  visMask.resize(data.size());
+  Workers::parallelFor(data,[this,&fr](LightSsbo& l) {
+    size_t id = size_t(std::distance(data.data(),&l));
+    visMask[id] = (l.range>0 && fr.testPoint(l.pos,l.range)) ? 1 : 0;
+    });
+
+  visible.clear();
+  for(size_t i=0; i<visMask.size(); ++i)
+    if(visMask[i]!=0)
+      visible.push_back(uint32_t(i));
+
+  auto& vbuf = visSsbo[fId];
+  const size_t capacity = std::max<size_t>(1,data.capacity());
+  if(vbuf.byteSize()<capacity*sizeof(uint32_t)) {
+    // sized for every light in bucket; recreated only when bucket itself grows
+    std::vector<uint32_t> zero(capacity);
+    vbuf = device.ssbo(BufferHeap::Upload,zero);
+    ubo[fId].set(10,vbuf);
+    }
+  if(visible.size()>0)
+    vbuf.update(visible.data(),0,visible.size()*sizeof(visible[0]));
+  }
+
 
 LightGroup::Light::Light(LightGroup::Light&& oth):owner(oth.owner), id(oth.id) {
   oth.owner = nullptr;
@@ -287,6 +356,10 @@ void LightGroup::dbgLights(DbgPainter& p) const {
   char  buf[250]={};
   std::snprintf(buf,sizeof(buf),"light count = %d",cnt);
   p.drawText(10,50,buf);
+
+  std::snprintf(buf,sizeof(buf),"visible lights = %d static, %d dynamic; upload = %d bytes",
+                int(stats.visibleSt),int(stats.visibleDyn),int(stats.uploadBytes));
+  p.drawText(10,50+int(Resources::font().pixelSize()),buf);
   }
 
 void LightGroup::free(size_t id) {
@@ -298,13 +371,11 @@ void LightGroup::free(size_t id) {
 
 LightGroup::LightSsbo& LightGroup::get(size_t id) {
   if(id & staticMask) {
-    for(auto& i:bucketSt.updated)
-      i = false;
+    bucketSt.markDirty(id^staticMask);
     return bucketSt.data[id^staticMask];
     }
 
-  for(auto& i:bucketDyn.updated)
-    i = false;
+  bucketDyn.markDirty(id);
   return bucketDyn.data[id];
   }
 
@@ -338,32 +409,27 @@ void LightGroup::tick(uint64_t time) {
     light.update(time);
 
     auto& ssbo = bucketDyn.data[i];
+    if(ssbo.pos==light.position() && ssbo.color==light.currentColor() && ssbo.range==light.currentRange())
+      continue;
     ssbo.pos   = light.position();
     ssbo.color = light.currentColor();
     ssbo.range = light.currentRange();
-
-    for(auto& updated:bucketDyn.updated)
-      updated = false;
+    bucketDyn.markDirty(i);
     }
   }
 
 void LightGroup::preFrameUpdate(uint8_t fId) {
-  auto& device = Resources::device();
+  Frustrum fr;
+  fr.make(scene.viewProject(),1,1);
+
+  stats.uploadBytes = 0;
   LightBucket* bucket[2] = {&bucketSt, &bucketDyn};
   for(auto b:bucket) {
-    if(b->updated[fId])
-      continue;
-    b->updated[fId] = true;
-    if(b->ssbo[fId].byteSize()==b->data.size()*sizeof(b->data[0])) {
-      b->ssbo[fId].update(b->data);
-      } else {
-      b->ssbo[fId] = device.ssbo(BufferHeap::Upload,b->data);
-      b->ubo [fId].set(4,b->ssbo[fId]);
-      }
+    stats.uploadBytes += b->upload(fId);
+    b->cull(fr,fId);
     }
-
-  Frustrum fr;
-  fr.make(scene.viewProject(),1,1);
+  stats.visibleSt  = bucketSt .visible.size();
+  stats.visibleDyn = bucketDyn.visible.size();
 
   Ubo ubo;
   ubo.mvp    = scene.viewProject();
@@ -382,13 +448,13 @@ void LightGroup::draw(Encoder<CommandBuffer>& cmd, uint8_t fId) {
     return;
 
   auto& p = shader();
-  if(bucketSt.data.size()>0) {
+  if(bucketSt.visible.size()>0) {
     cmd.setUniforms(p,bucketSt.ubo[fId]);
-    cmd.draw(vbo,ibo, 0,ibo.size(), 0,bucketSt.data.size());
+    cmd.draw(vbo,ibo, 0,ibo.size(), 0,bucketSt.visible.size());
     }
-  if(bucketDyn.data.size()>0) {
+  if(bucketDyn.visible.size()>0) {
     cmd.setUniforms(p,bucketDyn.ubo[fId]);
-    cmd.draw(vbo,ibo, 0,ibo.size(), 0,bucketDyn.data.size());
+    cmd.draw(vbo,ibo, 0,ibo.size(), 0,bucketDyn.visible.size());
     }
   }
 
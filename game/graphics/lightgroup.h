@@ -76,17 +76,37 @@ class LightGroup final {
       float         pading = 0;
       };
 
+    struct DirtyRange {
+      size_t begin = 0;
+      size_t end   = 0;
+      };
+
     struct LightBucket {
       std::vector<LightSource> light;
       std::vector<LightSsbo>   data;
       Tempest::StorageBuffer   ssbo[Resources::MaxFramesInFlight];
       bool                     updated[Resources::MaxFramesInFlight] = {};
+      DirtyRange               dirty  [Resources::MaxFramesInFlight] = {};
+
+      std::vector<uint8_t>     visMask;
+      std::vector<uint32_t>    visible;
+      Tempest::StorageBuffer   visSsbo[Resources::MaxFramesInFlight];
 
       std::vector<size_t>      freeList;
       Tempest::DescriptorSet   ubo[Resources::MaxFramesInFlight];
 
       size_t                   alloc();
       void                     free(size_t id);
+      void                     invalidate();
+      void                     markDirty(size_t id);
+      size_t                   upload(uint8_t fId);
+      void                     cull(const Frustrum& fr, uint8_t fId);
+      };
+
+    struct Stats {
+      size_t                   uploadBytes  = 0;
+      size_t                   visibleSt    = 0;
+      size_t                   visibleDyn   = 0;
       };
 
     size_t                            alloc(bool dynamic);
@@ -109,5 +129,6 @@ class LightGroup final {
 
     std::recursive_mutex              sync;
     LightBucket                       bucketSt, bucketDyn;
+    Stats                             stats;
   };
 
@@ -1,8 +1,10 @@
 #include "matrixstorage.h"
 
 #include <cstdint>
+#include <cstdio>
 
 #include "graphics/mesh/pose.h"
+#include "utils/dbgpainter.h"
 
 using namespace Tempest;
 
@@ -25,8 +27,7 @@ MatrixStorage::Id::~Id() {
 void MatrixStorage::Id::set(const Tempest::Matrix4x4* mat) {
   if(heapPtr!=nullptr) {
     std::memcpy(heapPtr->data.data()+rgn.begin, mat, rgn.size*sizeof(Tempest::Matrix4x4));
-    for(uint8_t i=0; i<Resources::MaxFramesInFlight; ++i)
-      heapPtr->durty[i].store(true);
+    heapPtr->owner->markDirty(*heapPtr,rgn);
     }
   }
 
@@ -34,11 +35,7 @@ void MatrixStorage::Id::set(const Tempest::Matrix4x4& obj, size_t offset) {
   if(heapPtr==nullptr)
     return;
   heapPtr->data[rgn.begin+offset] = obj;
-
-  if(heapPtr==&heapPtr->owner->upload)
-    return;
-  for(uint8_t i=0; i<Resources::MaxFramesInFlight; ++i)
-    heapPtr->durty[i].store(true);
+  heapPtr->owner->markDirty(*heapPtr,Range{rgn.begin+offset,1});
   }
 
 const StorageBuffer& MatrixStorage::Id::ssbo(uint8_t fId) const {
@@ -56,68 +53,117 @@ BufferHeap MatrixStorage::Id::heap() const {
 
 
 MatrixStorage::MatrixStorage() {
+  static_assert(Resources::MaxFramesInFlight<=8, "dirty mask is 8 bit");
+
   upload.data.reserve(2048);
-  upload.data.resize(1);
+  resize(upload,1);
   upload.data[0].identity();
   upload.owner = this;
 
   device.data.reserve(2048);
-  device.data.resize(1);
+  resize(device,1);
   device.data[0].identity();
   device.owner = this;
   }
 
 bool MatrixStorage::commit(uint8_t fId) {
+  uploadBytes = 0;
   bool ret = commit(upload,fId);
-  if(device.durty[fId].load()) {
-    ret |= commit(device,fId);
-    device.durty[fId].store(false);
-    }
+  ret |= commit(device,fId);
   return ret;
   }
 
 bool MatrixStorage::commit(Heap& heap, uint8_t fId) {
-  auto&  obj = heap.gpu[fId];
-  size_t sz  = heap.data.size() * sizeof(Tempest::Matrix4x4);
-  if(obj.byteSize()==sz) {
-    obj.update(heap.data);
+  auto&         obj = heap.gpu[fId];
+  const size_t  sz  = heap.data.size() * sizeof(Tempest::Matrix4x4);
+  const uint8_t bit = uint8_t(1u << fId);
+  const size_t  cnt = (heap.data.size()+BlockSize-1)/BlockSize;
+
+  if(obj.byteSize()!=sz) {
+    auto  bh     = (&heap==&upload ? BufferHeap::Upload : BufferHeap::Device);
+    auto& device = Resources::device();
+    obj = device.ssbo(bh,heap.data.data(),sz);
+    heap.durty[fId].store(false);
+    for(size_t i=0; i<cnt; ++i)
+      heap.dirty[i].fetch_and(uint8_t(~bit));
+    uploadBytes += sz;
+    return true;
+    }
+
+  if(!heap.durty[fId].exchange(false))
     return false;
+
+  // upload coalesced runs of dirty blocks
+  for(size_t i=0; i<cnt;) {
+    if((heap.dirty[i].fetch_and(uint8_t(~bit)) & bit)==0) {
+      ++i;
+      continue;
+      }
+    const size_t begin = i*BlockSize;
+    ++i;
+    while(i<cnt && (heap.dirty[i].fetch_and(uint8_t(~bit)) & bit)!=0)
+      ++i;
+    const size_t end = std::min(i*BlockSize, heap.data.size());
+    const size_t len = (end-begin)*sizeof(Tempest::Matrix4x4);
+    obj.update(heap.data.data()+begin, begin*sizeof(Tempest::Matrix4x4), len);
+    uploadBytes += len;
     }
-  auto  bh     = (&heap==&upload ? BufferHeap::Upload : BufferHeap::Device);
-  auto& device = Resources::device();
-  obj = device.ssbo(bh,heap.data.data(),sz);
-  return true;
+  return false;
+  }
+
+void MatrixStorage::markDirty(Heap& heap, const Range& r) {
+  if(r.size==0)
+    return;
+  const uint8_t mask = uint8_t((1u << Resources::MaxFramesInFlight)-1);
+  for(size_t i=r.begin/BlockSize; i<=(r.begin+r.size-1)/BlockSize; ++i) {
+    auto& d = heap.dirty[i];
+    if(d.load(std::memory_order_relaxed)!=mask)
+      d.fetch_or(mask);
+    }
+  for(uint8_t i=0; i<Resources::MaxFramesInFlight; ++i)
+    if(!heap.durty[i].load(std::memory_order_relaxed))
+      heap.durty[i].store(true);
+  }
+
+void MatrixStorage::resize(Heap& heap, size_t sz) {
+  heap.data.resize(sz);
+
+  const size_t cnt = (sz+BlockSize-1)/BlockSize;
+  if(cnt<=heap.dirtyCap)
+    return;
+  // new blocks are not dirty: gpu buffer is recreated on size change anyway
+  size_t cap = std::max<size_t>(heap.dirtyCap*2, cnt);
+  auto   d   = std::make_unique<std::atomic<uint8_t>[]>(cap);
+  for(size_t i=0; i<cap; ++i)
+    d[i].store(i<heap.dirtyCap ? heap.dirty[i].load() : uint8_t(0));
+  heap.dirty    = std::move(d);
+  heap.dirtyCap = cap;
   }
 
 MatrixStorage::Id MatrixStorage::alloc(BufferHeap heap, size_t nbones) {
   if(nbones==0)
     return Id(upload,Range());
 
-  auto& h = (heap==BufferHeap::Upload ? upload : device);
-  for(size_t i=0; i<h.rgn.size(); ++i) {
-    if(h.rgn[i].size==nbones) {
-      auto ret = h.rgn[i];
-      h.rgn.erase(h.rgn.begin()+intptr_t(i));
-      return Id(h,ret);
-      }
-    }
-  size_t retId = size_t(-1);
-  for(size_t i=0; i<h.rgn.size(); ++i) {
-    if(h.rgn[i].size>nbones && (retId==size_t(-1) || h.rgn[i].size<h.rgn[retId].size)) {
-      retId = i;
+  auto& h  = (heap==BufferHeap::Upload ? upload : device);
+  // best-fit: smallest free range, that is large enough; exact size-classes match first
+  auto  it = h.freeBySize.lower_bound({nbones,0});
+  if(it!=h.freeBySize.end()) {
+    const size_t size  = it->first;
+    const size_t begin = it->second;
+    h.freeBySize.erase(it);
+    h.freeByBegin.erase(begin);
+    if(size>nbones) {
+      h.freeByBegin.emplace(begin+nbones, size-nbones);
+      h.freeBySize .emplace(size-nbones,  begin+nbones);
       }
+    h.freeCount -= nbones;
+    return Id(h,Range{begin,nbones});
     }
-  if(retId!=size_t(-1)) {
-    auto ret = h.rgn[retId];
-    ret.size = nbones;
-    h.rgn[retId].begin += nbones;
-    h.rgn[retId].size  -= nbones;
-    return Id(h,ret);
-    }
+
   Range r;
   r.begin = h.data.size();
   r.size  = nbones;
-  h.data.resize(h.data.size()+r.size);
+  resize(h,h.data.size()+r.size);
   return Id(h,r);
   }
 
@@ -128,19 +174,52 @@ const Tempest::StorageBuffer& MatrixStorage::ssbo(Tempest::BufferHeap heap, uint
   }
 
 void MatrixStorage::free(Heap& heap, const Range& r) {
-  for(auto& i:heap.rgn) {
-    if(i.begin+i.size==r.begin) {
-      i.size+=r.size;
-      return;
-      }
-    if(r.begin+r.size==i.begin) {
-      i.begin -= r.size;
-      i.size  += r.size;
-      return;
+  if(r.size==0)
+    return;
+
+  Range rgn = r;
+  auto  next = heap.freeByBegin.lower_bound(rgn.begin);
+  // coalesce with left neighbour
+  if(next!=heap.freeByBegin.begin()) {
+    auto prev = std::prev(next);
+    if(prev->first+prev->second==rgn.begin) {
+      rgn.begin  = prev->first;
+      rgn.size  += prev->second;
+      heap.freeBySize.erase({prev->second,prev->first});
+      heap.freeByBegin.erase(prev);
       }
     }
-  auto at = std::lower_bound(heap.rgn.begin(),heap.rgn.end(),r,[](const Range& l, const Range& r){
-    return l.begin<r.begin;
-    });
-  heap.rgn.insert(at,r);
+  // coalesce with right neighbour
+  if(next!=heap.freeByBegin.end() && rgn.begin+rgn.size==next->first) {
+    rgn.size += next->second;
+    heap.freeBySize.erase({next->second,next->first});
+    heap.freeByBegin.erase(next);
+    }
+
+  heap.freeByBegin.emplace(rgn.begin,rgn.size);
+  heap.freeBySize .emplace(rgn.size, rgn.begin);
+  heap.freeCount += r.size;
+  }
+
+MatrixStorage::Stats MatrixStorage::stats() const {
+  Stats st;
+  st.uploadBytes = uploadBytes;
+  for(auto h:{&upload,&device}) {
+    st.usedBytes  += (h->data.size()-h->freeCount)*sizeof(Tempest::Matrix4x4);
+    st.freeBytes  += h->freeCount*sizeof(Tempest::Matrix4x4);
+    st.freeRanges += h->freeByBegin.size();
+    if(!h->freeBySize.empty())
+      st.largestFree = std::max(st.largestFree, h->freeBySize.rbegin()->first*sizeof(Tempest::Matrix4x4));
+    }
+  return st;
+  }
+
+void MatrixStorage::dbgDraw(DbgPainter& p) const {
+  auto st  = stats();
+  auto fnt = Resources::font().pixelSize();
+
+  char buf[250]={};
+  std::snprintf(buf,sizeof(buf),"skinning: upload = %d bytes; used = %d KB, free = %d KB in %d ranges (largest %d KB)",
+                int(st.uploadBytes),int(st.usedBytes/1024),int(st.freeBytes/1024),int(st.freeRanges),int(st.largestFree/1024));
+  p.drawText(10,50+2*int(fnt),buf);
   }
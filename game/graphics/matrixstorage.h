@@ -4,10 +4,16 @@
 #include <Tempest/Matrix4x4>
 #include <Tempest/UniformBuffer>
 
+#include <atomic>
+#include <map>
+#include <memory>
+#include <set>
 #include <vector>
 
 #include "resources.h"
 
+class DbgPainter;
+
 class MatrixStorage {
   private:
     struct Range {
@@ -38,22 +44,44 @@ class MatrixStorage {
         Range rgn;
       };
 
+    struct Stats {
+      size_t uploadBytes = 0; // during last commit
+      size_t usedBytes   = 0;
+      size_t freeBytes   = 0;
+      size_t freeRanges  = 0;
+      size_t largestFree = 0;
+      };
+
     MatrixStorage();
 
-    Id   alloc(Tempest::BufferHeap heap, size_t nbones);
-    auto ssbo (Tempest::BufferHeap heap, uint8_t fId) const -> const Tempest::StorageBuffer&;
-    bool commit(uint8_t fId);
+    Id    alloc(Tempest::BufferHeap heap, size_t nbones);
+    auto  ssbo (Tempest::BufferHeap heap, uint8_t fId) const -> const Tempest::StorageBuffer&;
+    bool  commit(uint8_t fId);
+
+    Stats stats() const;
+    void  dbgDraw(DbgPainter& p) const;
 
   private:
+    enum {
+      BlockSize = 64, // matrices per dirty-tracking block
+      };
+
     bool commit(Heap& heap, uint8_t fId);
     void free(Heap& heap, const Range& r);
+    void resize(Heap& heap, size_t sz);
+    void markDirty(Heap& heap, const Range& r);
 
     struct Heap {
-      MatrixStorage*                  owner = nullptr;
-      std::vector<Range>              rgn;
-      std::vector<Tempest::Matrix4x4> data;
-      Tempest::StorageBuffer          gpu[Resources::MaxFramesInFlight];
-      std::atomic_bool                durty[Resources::MaxFramesInFlight] = {};
+      MatrixStorage*                          owner = nullptr;
+      std::map<size_t,size_t>                 freeByBegin; // begin -> size
+      std::set<std::pair<size_t,size_t>>      freeBySize;  // {size, begin}, for best-fit
+      size_t                                  freeCount = 0;
+      std::vector<Tempest::Matrix4x4>         data;
+      std::unique_ptr<std::atomic<uint8_t>[]> dirty;       // per block: bit per frame in flight
+      size_t                                  dirtyCap  = 0;
+      Tempest::StorageBuffer                  gpu[Resources::MaxFramesInFlight];
+      std::atomic_bool                        durty[Resources::MaxFramesInFlight] = {};
       };
-    Heap upload, device;
+    Heap   upload, device;
+    size_t uploadBytes = 0;
   };
@@ -466,13 +466,8 @@ bool MdlVisual::isUsingTorch() const {
 bool MdlVisual::updateAnimation(Npc* npc, World& world, uint64_t dt) {
   Pose&    pose      = *skInst;
   uint64_t tickCount = world.tickCount();
-  auto     pos3      = Vec3{pos.at(3,0), pos.at(3,1), pos.at(3,2)};
-
-  if(npc!=nullptr && world.isInSfxRange(pos3))
-    pose.processSfx(*npc,tickCount);
-  if(world.isInPfxRange(pos3))
-    pose.processPfx(*this,world,tickCount);
 
+  processFx(npc,world);
   for(size_t i=0;i<effects.size();) {
     if(effects[i].timeUntil<tickCount) {
       effects[i] = std::move(effects.back());
@@ -485,13 +480,45 @@ bool MdlVisual::updateAnimation(Npc* npc, World& world, uint64_t dt) {
 
   solver.update(tickCount);
   pose.setObjectMatrix(pos,false);
-  const bool changed = pose.update(tickCount);
+  const bool changed = pose.update(tickCount) || poseSynced;
+  poseStale  = false;
+  poseSynced = false;
 
   if(changed)
     view.setPose(pos,pose);
   return changed;
   }
 
+void MdlVisual::skipAnimation(Npc* npc, World& world) {
+  poseTick  = world.tickCount();
+  poseStale = true;
+  processFx(npc,world);
+  solver.update(poseTick);
+  }
+
+void MdlVisual::processFx(Npc* npc, World& world) {
+  Pose&    pose      = *skInst;
+  uint64_t tickCount = world.tickCount();
+  auto     pos3      = Vec3{pos.at(3,0), pos.at(3,1), pos.at(3,2)};
+
+  if(npc!=nullptr && world.isInSfxRange(pos3))
+    pose.processSfx(*npc,tickCount);
+  if(world.isInPfxRange(pos3))
+    pose.processPfx(*this,world,tickCount);
+  pose.setFxBarrier(tickCount);
+  }
+
+void MdlVisual::syncPose() const {
+  if(!poseStale)
+    return;
+  poseStale = false;
+  // view is updated on next full update
+  Pose& pose = *skInst;
+  pose.setObjectMatrix(pos,false);
+  if(pose.update(poseTick))
+    poseSynced = true;
+  }
+
 void MdlVisual::processLayers(World& world) {
   Pose&    pose      = *skInst;
   uint64_t tickCount = world.tickCount();
@@ -509,10 +536,19 @@ Vec3 MdlVisual::mapBone(const size_t boneId) const {
   if(boneId==size_t(-1))
     return {pos.at(3,0), pos.at(3,1), pos.at(3,2)};
 
+  syncPose();
   auto mat = pose.bone(boneId);
   return {mat.at(3,0), mat.at(3,1), mat.at(3,2)};
   }
 
+Matrix4x4 MdlVisual::boneMatrix(const size_t boneId) const {
+  syncPose();
+  Pose& pose = *skInst;
+  if(boneId<pose.boneCount())
+    return pose.bone(boneId);
+  return pos;
+  }
+
 Vec3 MdlVisual::mapWeaponBone() const {
   if(fgtMode==WeaponState::Bow || fgtMode==WeaponState::CBow)
     return mapBone(ammunition.boneId);
@@ -745,7 +781,7 @@ float MdlVisual::viewDirection() const {
   if(nullptr!=skeleton) {
     size_t nodeId = skeleton->findNode("BIP01");
     if(nodeId!=size_t(-1))
-      p = pose().bone(nodeId);
+      p = boneMatrix(nodeId);
     }
   float rx = p.at(2,0);
   float rz = p.at(2,2);
@@ -846,6 +882,7 @@ template<class View>
 void MdlVisual::syncAttaches(Attach<View>& att) {
   if(att.view.isEmpty())
     return;
+  syncPose();
   auto& pose = *skInst;
   auto  p    = pos;
   if(att.boneId<pose.boneCount())
@@ -74,9 +74,11 @@ class MdlVisual final {
 
     const Pose&                    pose() const { return *skInst; }
     bool                           updateAnimation(Npc* npc, World& world, uint64_t dt);
+    void                           skipAnimation  (Npc* npc, World& world);
     void                           processLayers  (World& world);
     bool                           processEvents(World& world, uint64_t &barrier, Animation::EvCount &ev);
     auto                           mapBone(const size_t boneId) const -> Tempest::Vec3;
+    auto                           boneMatrix(const size_t boneId) const -> Tempest::Matrix4x4;
     auto                           mapWeaponBone() const -> Tempest::Vec3;
     auto                           mapHeadBone() const -> Tempest::Vec3;
 
@@ -143,6 +145,8 @@ class MdlVisual final {
     void bind(Attach<View>& slot, std::string_view bone);
     template<class View>
     void syncAttaches(Attach<View>& mesh);
+    void syncPose() const;
+    void processFx(Npc* npc, World& world);
 
     template<class View>
     void rebindAttaches(Attach<View>& mesh, const Skeleton& to);
@@ -170,5 +174,10 @@ class MdlVisual final {
     WeaponState                    fgtMode=WeaponState::NoWeapon;
     AnimationSolver                solver;
     std::unique_ptr<Pose>          skInst;
+
+    // pose sampling skipped by animation LOD; bones are evaluated on first bone query
+    uint64_t                       poseTick   = 0;
+    mutable bool                   poseStale  = false;
+    mutable bool                   poseSynced = false;
   };
 
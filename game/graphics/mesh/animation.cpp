@@ -2,6 +2,7 @@
 
 #include <Tempest/Log>
 #include <cctype>
+#include <unordered_map>
 
 #include <zenload/modelAnimationParser.h>
 #include <zenload/zCModelPrototype.h>
@@ -216,6 +217,26 @@ void Animation::debug() const {
     Log::d(i.name);
   }
 
+size_t Animation::memoryUsage() const {
+  size_t ret = sequences.capacity()*sizeof(Sequence);
+  for(size_t i=0; i<sequences.size(); ++i) {
+    auto& d = sequences[i].data;
+    if(d==nullptr)
+      continue;
+    // aliases share data with the original sequence
+    bool dup = false;
+    for(size_t r=0; r<i && !dup; ++r)
+      dup = (sequences[r].data==d);
+    if(dup)
+      continue;
+    ret += sizeof(AnimData);
+    ret += d->samples.capacity()*sizeof(d->samples[0]);
+    ret += d->nodeIndex.capacity()*sizeof(d->nodeIndex[0]);
+    ret += d->tr.capacity()*sizeof(d->tr[0]);
+    }
+  return ret;
+  }
+
 const std::string& Animation::defaultMesh() const {
   if(meshDef.mds.size()>0 && !meshDef.disabled)
     return meshDef.mds;
@@ -270,13 +291,18 @@ void Animation::setupIndex() {
     return a.name<b.name;
     });
 
+  // first sequence by askName, same as sequenceAsc
+  std::unordered_map<std::string_view,const Sequence*> asc;
+  for(auto& s:sequences)
+    asc.emplace(s.askName,&s);
   for(auto& s:sequences) {
     if(s.comb.size()==0)
       continue;
     for(size_t i=0;i<s.comb.size();++i) {
       char name[256]={};
       std::snprintf(name,sizeof(name),"%s%d",s.askName.c_str(),int(i+1));
-      s.comb[i] = sequenceAsc(name);
+      auto it = asc.find(name);
+      s.comb[i] = it!=asc.end() ? it->second : nullptr;
       }
     }
 
@@ -134,6 +134,7 @@ class Animation final {
     const Sequence*    sequenceAsc(std::string_view name) const;
     void               debug() const;
     const std::string& defaultMesh() const;
+    size_t             memoryUsage() const;
 
   private:
     Sequence&          loadMAN(const ZenLoad::zCModelScriptAni& hdr, const std::string &name);
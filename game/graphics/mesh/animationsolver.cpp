@@ -359,10 +359,34 @@ const Animation::Sequence *AnimationSolver::solveAnim(Interactive *inter, Animat
     }
   }
 
-const Animation::Sequence *AnimationSolver::solveFrm(std::string_view fview, WeaponState st) const {
-  char format[256] = {};
-  std::snprintf(format,sizeof(format),"%.*s",int(fview.size()),fview.data());
+// substitutes every '%s' in format with arg
+static std::string_view formatName(char (&buf)[128], std::string_view format, std::string_view arg) {
+  size_t n = 0;
+  for(size_t i=0; i<format.size() && n<sizeof(buf); ++i) {
+    if(format[i]=='%' && i+1<format.size() && format[i+1]=='s') {
+      for(auto c:arg)
+        if(n<sizeof(buf))
+          buf[n++] = c;
+      ++i;
+      continue;
+      }
+    buf[n++] = format[i];
+    }
+  return std::string_view(buf,n);
+  }
+
+const Animation::Sequence *AnimationSolver::solveFrm(std::string_view format, WeaponState st) const {
+  // all formats are string literals from this file, so pointer is a stable key
+  auto&      e   = formats[format.data()];
+  const auto bit = uint8_t(1u << int(st));
+  if((e.resolved & bit)==0) {
+    e.seq[int(st)] = implSolveFrm(format,st);
+    e.resolved    |= bit;
+    }
+  return e.seq[int(st)];
+  }
 
+const Animation::Sequence *AnimationSolver::implSolveFrm(std::string_view format, WeaponState st) const {
   static const char* weapon[] = {
     "",
     "FIST",
@@ -373,23 +397,16 @@ const Animation::Sequence *AnimationSolver::solveFrm(std::string_view fview, Wea
     "MAG"
     };
   char name[128]={};
-  std::snprintf(name,sizeof(name),format,weapon[int(st)],weapon[int(st)]);
-  if(auto ret=solveFrm(name))
+  if(auto ret=solveFrm(formatName(name,format,weapon[int(st)])))
     return ret;
-  std::snprintf(name,sizeof(name),format,"");
-  if(auto ret=solveFrm(name))
+  if(auto ret=solveFrm(formatName(name,format,"")))
     return ret;
-  std::snprintf(name,sizeof(name),format,"FIST");
-  return solveFrm(name);
+  return solveFrm(formatName(name,format,"FIST"));
   }
 
-const Animation::Sequence* AnimationSolver::solveMag(std::string_view fview, const std::string &spell) const {
-  char format[256] = {};
-  std::snprintf(format,sizeof(format),"%.*s",int(fview.size()),fview.data());
-
+const Animation::Sequence* AnimationSolver::solveMag(std::string_view format, const std::string &spell) const {
   char name[128]={};
-  std::snprintf(name,sizeof(name),format,spell.c_str());
-  return solveFrm(name);
+  return solveFrm(formatName(name,format,spell));
   }
 
 const Animation::Sequence *AnimationSolver::solveDead(std::string_view format1, std::string_view format2) const {
@@ -400,6 +417,8 @@ const Animation::Sequence *AnimationSolver::solveDead(std::string_view format1,
 
 void AnimationSolver::invalidateCache() {
   std::memset(cache,0,sizeof(cache));
+  names.clear();
+  formats.clear();
   }
 
 const Animation::Sequence* AnimationSolver::solveNext(const Animation::Sequence& sq) const {
@@ -422,6 +441,15 @@ const Animation::Sequence *AnimationSolver::solveFrm(std::string_view name) cons
   if(name.empty())
     return nullptr;
 
+  auto it = names.find(name);
+  if(it!=names.end())
+    return it->second;
+  auto ret = implSolveFrm(name);
+  names.emplace(name,ret);
+  return ret;
+  }
+
+const Animation::Sequence *AnimationSolver::implSolveFrm(std::string_view name) const {
   for(size_t i=overlay.size();i>0;){
     --i;
     if(auto s = overlay[i].skeleton->sequence(name))
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Tempest/Matrix4x4>
+#include <unordered_map>
 #include <vector>
 
 #include "game/constants.h"
@@ -90,7 +91,20 @@ class AnimationSolver final {
     const Animation::Sequence*     solveAnim(Interactive *inter, Anim a, const Pose &pose) const;
 
   private:
+    struct NameHash {
+      using is_transparent = void;
+      size_t operator()(std::string_view s) const { return std::hash<std::string_view>()(s); }
+      };
+
+    // resolved weapon-variants of a format string
+    struct FrmEntry {
+      const Animation::Sequence* seq[int(WeaponState::Mage)+1] = {};
+      uint8_t                    resolved = 0;
+      };
+
     const Animation::Sequence*     solveFrm    (std::string_view format, WeaponState st) const;
+    const Animation::Sequence*     implSolveFrm(std::string_view format, WeaponState st) const;
+    const Animation::Sequence*     implSolveFrm(std::string_view name) const;
 
     const Animation::Sequence*     solveMag    (std::string_view format, const std::string& spell) const;
     const Animation::Sequence*     solveDead   (std::string_view format1, std::string_view format2) const;
@@ -102,4 +116,7 @@ class AnimationSolver final {
     std::vector<Overlay>           overlay;
 
     mutable const Animation::Sequence* cache [CacheLast][2][2] = {};
+    // lookup tables for current skeleton+overlays; built lazily, dropped in invalidateCache
+    mutable std::unordered_map<std::string,const Animation::Sequence*,NameHash,std::equal_to<>> names;
+    mutable std::unordered_map<const char*,FrmEntry>                                           formats;
   };
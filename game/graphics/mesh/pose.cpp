@@ -78,6 +78,7 @@ void Pose::load(Serialize &fin, const AnimationSolver& solver) {
     i.seq = solver.solveFrm(name);
     }
   fin.read(lastUpdate);
+  lastFx = lastUpdate;
   fin.read(combo.bits);
   removeIf(lay,[](const Layer& l){
     return l.seq==nullptr;
@@ -395,28 +396,54 @@ bool Pose::updateFrame(const Animation::Sequence &s, BodyState bs,
   return true;
   }
 
+// a*b, for matrices with last row {0,0,0,1}: skips multiplications by constant row
+static void mulAffine(Matrix4x4& ret, const Matrix4x4& a, const Matrix4x4& b) {
+  const float* x = a.data();
+  const float* y = b.data();
+  float        r[16];
+  for(int j=0; j<4; ++j) {
+    const float* yj = y + j*4;
+    const float  w  = (j==3 ? 1.f : 0.f);
+    for(int i=0; i<3; ++i)
+      r[j*4+i] = x[i]*yj[0] + x[4+i]*yj[1] + x[8+i]*yj[2] + x[12+i]*w;
+    r[j*4+3] = w;
+    }
+  ret = Matrix4x4(r);
+  }
+
+static bool isAffine(const Matrix4x4& m) {
+  return m.at(0,3)==0.f && m.at(1,3)==0.f && m.at(2,3)==0.f && m.at(3,3)==1.f;
+  }
+
 void Pose::mkSkeleton(const Tempest::Matrix4x4& mt) {
   if(skeleton==nullptr)
     return;
   Matrix4x4 m = mt;
   m.translate(mkBaseTranslation());
-  if(skeleton->ordered)
-    implMkSkeleton(m); else
-    implMkSkeleton(m,size_t(-1));
+  if(skeleton->affine && isAffine(m))
+    implMkSkeleton<true>(m); else
+    implMkSkeleton<false>(m);
   }
 
+template<bool affine>
 void Pose::implMkSkeleton(const Matrix4x4 &mt) {
-  if(skeleton==nullptr)
-    return;
   auto& nodes      = skeleton->nodes;
   auto  BIP01_HEAD = skeleton->BIP01_HEAD;
-  for(size_t i=0; i<nodes.size(); ++i) {
-    size_t parent = nodes[i].parent;
-    auto   mat    = hasSamples[i] ? mkMatrix(base[i]) : nodes[i].tr;
-
-    if(parent<Resources::MAX_NUM_SKELETAL_NODES)
-      tr[i] = tr[parent]*mat; else
-      tr[i] = mt*mat;
+  // single pass in parent-first order, no recursion for unordered skeletons
+  for(size_t i:skeleton->order) {
+    const size_t     parent = nodes[i].parent;
+    const Matrix4x4& pmat   = parent<Resources::MAX_NUM_SKELETAL_NODES ? tr[parent] : mt;
+
+    if(hasSamples[i]) {
+      const Matrix4x4 mat = mkMatrix(base[i]);
+      if(affine)
+        mulAffine(tr[i],pmat,mat); else
+        tr[i] = pmat*mat;
+      } else {
+      if(affine)
+        mulAffine(tr[i],pmat,nodes[i].tr); else
+        tr[i] = pmat*nodes[i].tr;
+      }
 
     if(i==BIP01_HEAD && (headRotX!=0 || headRotY!=0)) {
       Matrix4x4& m = tr[i];
@@ -426,19 +453,6 @@ void Pose::implMkSkeleton(const Matrix4x4 &mt) {
     }
   }
 
-void Pose::implMkSkeleton(const Tempest::Matrix4x4 &mt, size_t parent) {
-  if(skeleton==nullptr)
-    return;
-  auto& nodes = skeleton->nodes;
-  for(size_t i=0;i<nodes.size();++i){
-    if(nodes[i].parent!=parent)
-      continue;
-    auto mat = hasSamples[i] ? mkMatrix(base[i]) : nodes[i].tr;
-    tr[i] = mt*mat;
-    implMkSkeleton(tr[i],i);
-    }
-  }
-
 const Animation::Sequence* Pose::solveNext(const AnimationSolver &solver, const Layer& lay) {
   auto sq = lay.seq;
 
@@ -530,12 +544,12 @@ bool Pose::hasLayerEvents(const Pose::Layer& l) {
 
 void Pose::processSfx(Npc &npc, uint64_t tickCount) {
   for(auto& i:lay)
-    i.seq->processSfx(lastUpdate,i.sAnim,tickCount,npc);
+    i.seq->processSfx(lastFx,i.sAnim,tickCount,npc);
   }
 
 void Pose::processPfx(MdlVisual& visual, World& world, uint64_t tickCount) {
   for(auto& i:lay)
-    i.seq->processPfx(lastUpdate,i.sAnim,tickCount,visual,world);
+    i.seq->processPfx(lastFx,i.sAnim,tickCount,visual,world);
   }
 
 bool Pose::processEvents(uint64_t &barrier, uint64_t now, Animation::EvCount &ev) const {
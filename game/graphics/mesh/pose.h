@@ -55,6 +55,7 @@ class Pose final {
     Tempest::Vec3      animMoveSpeed(uint64_t tickCount, uint64_t dt) const;
     void               processSfx(Npc &npc, uint64_t tickCount);
     void               processPfx(MdlVisual& visual, World& world, uint64_t tickCount);
+    void               setFxBarrier(uint64_t tickCount) { lastFx = tickCount; }
     bool               isDefParWindow(uint64_t tickCount) const;
     bool               isDefWindow(uint64_t tickCount) const;
     bool               isDefence(uint64_t tickCount) const;
@@ -110,8 +111,8 @@ class Pose final {
 
     auto mkBaseTranslation() -> Tempest::Vec3;
     void mkSkeleton(const Tempest::Matrix4x4 &mt);
+    template<bool affine>
     void implMkSkeleton(const Tempest::Matrix4x4 &mt);
-    void implMkSkeleton(const Tempest::Matrix4x4 &mt, size_t parent);
 
     bool updateFrame(const Animation::Sequence &s, BodyState bs, uint64_t barrier, uint64_t sTime, uint64_t now);
 
@@ -134,6 +135,7 @@ class Pose final {
     float                           trY=0;
     Flags                           flag=NoFlags;
     uint64_t                        lastUpdate=0;
+    uint64_t                        lastFx=0; // sfx/pfx barrier, independent of pose sampling
     ComboState                      combo;
     bool                            needToUpdate = true;
     uint8_t                         hasEvents = 0;
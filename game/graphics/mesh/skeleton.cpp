@@ -36,6 +36,10 @@ Skeleton::Skeleton(const ZenLoad::zCModelMeshLib& src, const Animation* anim, st
   for(size_t i=0;i<nodes.size();++i)
     if(nodes[i].parent==size_t(-1))
       rootNodes.push_back(i);
+  for(auto& i:nodes)
+    if(i.tr.at(0,3)!=0.f || i.tr.at(1,3)!=0.f || i.tr.at(2,3)!=0.f || i.tr.at(3,3)!=1.f)
+      affine = false;
+  mkOrder();
 
   auto tr = src.getRootNodeTranslation();
   rootTr = Vec3{tr.x,tr.y,tr.z};
@@ -91,6 +95,22 @@ void Skeleton::mkSkeleton() {
   mkSkeleton(m,size_t(-1));
   }
 
+void Skeleton::mkOrder() {
+  order.reserve(nodes.size());
+  if(ordered) {
+    for(size_t i=0;i<nodes.size();++i)
+      order.push_back(i);
+    return;
+    }
+  // breadth-first from roots
+  order = rootNodes;
+  for(size_t at=0; at<order.size(); ++at) {
+    for(size_t i=0;i<nodes.size();++i)
+      if(nodes[i].parent==order[at])
+        order.push_back(i);
+    }
+  }
+
 void Skeleton::mkSkeleton(const Tempest::Matrix4x4 &mt, size_t parent) {
   for(size_t i=0;i<nodes.size();++i){
     if(nodes[i].parent!=parent)
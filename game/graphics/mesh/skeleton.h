@@ -19,7 +19,9 @@ class Skeleton final {
       };
 
     bool                            ordered=true;
+    bool                            affine=true;  // all local transforms have last row {0,0,0,1}
     std::vector<Node>               nodes;
+    std::vector<size_t>             order;        // parents before children
     std::vector<size_t>             rootNodes;
     std::vector<Tempest::Matrix4x4> tr;
     Tempest::Vec3                   rootTr={};
@@ -45,4 +47,5 @@ class Skeleton final {
 
     void mkSkeleton();
     void mkSkeleton(const Tempest::Matrix4x4& mt,size_t parent);
+    void mkOrder();
   };
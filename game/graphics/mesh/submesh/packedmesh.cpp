@@ -3,7 +3,10 @@
 #include <Tempest/Log>
 #include <fstream>
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 
+#include "utils/workers.h"
 #include "gothic.h"
 
 using namespace Tempest;
@@ -14,6 +17,7 @@ void PackedMesh::Meshlet::flush(std::vector<Vertex>&   vertices,
                                 SubMesh& sub, const ZenLoad::zCMesh& mesh) {
   if(indSz==0)
     return;
+  optimizeOrder();
   instances.push_back(bounds);
 
   auto& vbo = mesh.getVertices();  // xyz
@@ -63,6 +67,7 @@ void PackedMesh::Meshlet::flush(std::vector<Vertex>&   vertices,
                                 const std::vector<SkeletalData>* skeletal) {
   if(indSz==0)
     return;
+  optimizeOrder();
 
   auto& vbo = vboList;    // xyz
   auto& uv  = wedgeList;  // uv, normal
@@ -201,6 +206,97 @@ void PackedMesh::Meshlet::clear() {
   indSz  = 0;
   }
 
+static float vertexScore(int cachePos, uint32_t valence) {
+  // Tom Forsyth, "Linear-Speed Vertex Cache Optimisation"
+  if(valence==0)
+    return -1.f;
+  float score = 0;
+  if(cachePos<0) {
+    score = 0;
+    } else
+  if(cachePos<3) {
+    score = 0.75f;
+    } else {
+    float k = 1.f - float(cachePos-3)/float(PackedMesh::CacheSize-3);
+    score = std::pow(k,1.5f);
+    }
+  return score + 2.f/std::sqrt(float(valence));
+  }
+
+void PackedMesh::Meshlet::optimizeOrder() {
+  const size_t triCount = indSz/3;
+
+  uint8_t valence [MaxVert]   = {};
+  int     cachePos[MaxVert]   = {};
+  float   score   [MaxVert]   = {};
+  bool    emitted [MaxInd/3]  = {};
+  uint8_t cache   [CacheSize+3] = {};
+  size_t  cacheSz = 0;
+
+  for(size_t i=0; i<indSz; ++i)
+    valence[indexes[i]]++;
+  for(size_t i=0; i<vertSz; ++i) {
+    cachePos[i] = -1;
+    score[i]    = vertexScore(-1,valence[i]);
+    }
+
+  // triangle order: greedy, by cache and valence score
+  uint8_t ibo[MaxInd] = {};
+  for(size_t n=0; n<triCount; ++n) {
+    size_t best      = 0;
+    float  bestScore = -1;
+    for(size_t t=0; t<triCount; ++t) {
+      if(emitted[t])
+        continue;
+      const uint8_t* tri = &indexes[t*3];
+      float s = score[tri[0]] + score[tri[1]] + score[tri[2]];
+      if(s>bestScore) {
+        bestScore = s;
+        best      = t;
+        }
+      }
+
+    emitted[best] = true;
+    const uint8_t* tri = &indexes[best*3];
+    for(size_t i=0; i<3; ++i) {
+      ibo[n*3+i] = tri[i];
+      valence[tri[i]]--;
+      }
+
+    // LRU: triangle vertices go to the front
+    uint8_t next[CacheSize+3] = {tri[0],tri[1],tri[2]};
+    size_t  nextSz            = 3;
+    for(size_t i=0; i<cacheSz; ++i) {
+      auto v = cache[i];
+      if(v!=tri[0] && v!=tri[1] && v!=tri[2])
+        next[nextSz++] = v;
+      }
+    for(size_t i=0; i<nextSz; ++i) {
+      cachePos[next[i]] = i<CacheSize ? int(i) : -1;
+      score   [next[i]] = vertexScore(cachePos[next[i]],valence[next[i]]);
+      }
+    cacheSz = std::min<size_t>(nextSz,CacheSize);
+    std::memcpy(cache,next,cacheSz);
+    }
+
+  // vertex fetch order: first use
+  uint8_t remap[MaxVert] = {};
+  Vert    vbo  [MaxVert] = {};
+  uint8_t vSz            = 0;
+  std::memset(remap,0xFF,sizeof(remap));
+  for(size_t i=0; i<indSz; ++i) {
+    auto v = ibo[i];
+    if(remap[v]==0xFF) {
+      remap[v]  = vSz;
+      vbo[vSz]  = vert[v];
+      ++vSz;
+      }
+    indexes[i] = remap[v];
+    }
+  std::copy(vbo,vbo+vSz,vert);
+  vertSz = vSz;
+  }
+
 void PackedMesh::Meshlet::updateBounds(const ZenLoad::zCMesh& mesh) {
   updateBounds(mesh.getVertices());
   }
@@ -301,7 +397,7 @@ PackedMesh::PackedMesh(const ZenLoad::zCMesh& mesh, PkgType type) {
     }
 
   if(type==PK_VisualLnd || type==PK_Visual) {
-    packMeshlets(mesh);
+    packMeshlets(mesh,type==PK_VisualLnd);
     computeBbox();
     return;
     }
@@ -445,7 +541,7 @@ void PackedMesh::packPhysics(const ZenLoad::zCMesh& mesh, PkgType type) {
     }
   }
 
-void PackedMesh::packMeshlets(const ZenLoad::zCMesh& mesh) {
+void PackedMesh::packMeshlets(const ZenLoad::zCMesh& mesh, bool parallel) {
   auto& ibo  = mesh.getIndices();
   auto& feat = mesh.getFeatureIndices();
   auto& mat  = mesh.getTriangleMaterialIndices();
@@ -469,26 +565,72 @@ void PackedMesh::packMeshlets(const ZenLoad::zCMesh& mesh) {
       }
     }
 
-  for(size_t mId=0; mId<mesh.getMaterials().size(); ++mId) {
-    std::vector<Meshlet> meshlets;
-    Meshlet activeMeshlets[16];
-
-    if(duplicates[mId]!=mId)
-      continue;
+  struct Pack {
+    size_t                matId = 0;
+    std::vector<uint32_t> triangles;
+    std::vector<Meshlet>  meshlets;
+    std::vector<Meshlet*> ind;
+    };
+
+  // bucket triangles by material in a single pass
+  std::vector<Pack>   packs;
+  std::vector<size_t> packId(mesh.getMaterials().size(),size_t(-1));
+  for(size_t i=0; i<ibo.size(); i+=3) {
+    size_t mId = duplicates[size_t(mat[i/3u])];
+    if(packId[mId]==size_t(-1)) {
+      packId[mId] = packs.size();
+      packs.emplace_back();
+      packs.back().matId = mId;
+      }
+    packs[packId[mId]].triangles.push_back(uint32_t(i));
+    }
 
-    for(size_t i=0; i<ibo.size(); i+=3) {
-      if(duplicates[size_t(mat[i/3u])]!=mId)
-        continue;
+  auto build = [&](Pack& p) {
+    Meshlet activeMeshlets[MaxMeshlets];
+    for(auto i:p.triangles) {
       auto a = std::make_pair(ibo[i+0],feat[i+0]);
       auto b = std::make_pair(ibo[i+1],feat[i+1]);
       auto c = std::make_pair(ibo[i+2],feat[i+2]);
-      addIndex(activeMeshlets,16,meshlets, a,b,c);
+      addIndex(activeMeshlets,MaxMeshlets,p.meshlets, a,b,c);
       }
-
     for(auto& meshlet:activeMeshlets)
       if(meshlet.indSz>0)
-        meshlets.push_back(std::move(meshlet));
-    postProcessP1(mesh,mId,meshlets);
+        p.meshlets.push_back(std::move(meshlet));
+    postProcessP1(mesh,p.meshlets,p.ind);
+    p.triangles = std::vector<uint32_t>();
+    };
+
+  if(parallel && packs.size()>1) {
+    // biggest materials first, to balance workers
+    std::vector<Pack*> queue(packs.size());
+    for(size_t i=0; i<packs.size(); ++i)
+      queue[i] = &packs[i];
+    std::sort(queue.begin(),queue.end(),[](const Pack* l, const Pack* r){
+      return l->triangles.size()>r->triangles.size();
+      });
+
+    std::atomic_size_t next{0};
+    Workers::parallelTasks(std::max<size_t>(1,Workers::maxThreads()),[&](uintptr_t) {
+      while(true) {
+        size_t id = next.fetch_add(1);
+        if(id>=queue.size())
+          break;
+        build(*queue[id]);
+        }
+      });
+    } else {
+    for(auto& p:packs)
+      build(p);
+    }
+
+  // flush in material order: output doesn't depend on worker scheduling
+  std::sort(packs.begin(),packs.end(),[](const Pack& l, const Pack& r){
+    return l.matId<r.matId;
+    });
+  for(auto& p:packs) {
+    postProcessP2(mesh,p.matId,p.ind);
+    // dbgUtilization(p.ind);
+    // dbgMeshlets(mesh,p.ind);
     }
   }
 
@@ -535,7 +677,7 @@ void PackedMesh::packMeshlets(const ZenLoad::zCProgMeshProto& mesh, PkgType type
     }
   }
 
-void PackedMesh::sortPass(std::vector<Meshlet*>& meshlets) {
+void PackedMesh::sortPass(std::vector<Meshlet*>& meshlets) const {
   if(meshlets.size()<2)
     return;
 
@@ -592,7 +734,12 @@ void PackedMesh::sortPass(std::vector<Meshlet*>& meshlets) {
     });
   }
 
-void PackedMesh::mergePass(std::vector<Meshlet*>& ind, bool fast) {
+void PackedMesh::mergePass(std::vector<Meshlet*>& ind, bool fast) const {
+  if(!fast && ind.size()>256) {
+    mergePassGrid(ind);
+    return;
+    }
+
   for(size_t i=0; i<ind.size(); ++i) {
     auto mesh = ind[i];
     if(mesh==nullptr)
@@ -609,7 +756,7 @@ void PackedMesh::mergePass(std::vector<Meshlet*>& ind, bool fast) {
         }
       float qDist = mesh->qDistance(*ind[r]);
       float R     = (mesh->bounds.r+ind[r]->bounds.r)*0.5f;
-      if(qDist>(500.f*500.f) && qDist>R*R) {
+      if(qDist>(MergeDist*MergeDist) && qDist>R*R) {
         // 5 meters or radius
         if(fast)
           break;
@@ -630,26 +777,106 @@ void PackedMesh::mergePass(std::vector<Meshlet*>& ind, bool fast) {
   ind.resize(n);
   }
 
-void PackedMesh::postProcessP1(const ZenLoad::zCMesh& mesh, size_t matId, std::vector<Meshlet>& meshlets) {
-  if(meshlets.size()<=1) {
-    SubMesh sub;
-    sub.material  = mesh.getMaterials()[matId];
-    sub.iboOffset = indices.size();
-    for(auto& m:meshlets) {
-      m.updateBounds(mesh);
-      m.flush(vertices,indices,meshletBounds,sub,mesh);
+void PackedMesh::mergePassGrid(std::vector<Meshlet*>& ind) const {
+  // Same result as the exhaustive mergePass: candidates are still visited in index order,
+  // but only meshlets that may pass the distance test are looked at.
+  // Meshlets with r<=MergeDist can only merge with each other within MergeDist - those go to a grid;
+  // rare bigger ones are tested against everything.
+  const float cellSz = float(MergeDist);
+
+  Vec3 minP = ind[0]->bounds.pos;
+  for(auto i:ind) {
+    minP.x = std::min(minP.x, i->bounds.pos.x);
+    minP.y = std::min(minP.y, i->bounds.pos.y);
+    minP.z = std::min(minP.z, i->bounds.pos.z);
+    }
+
+  auto cellOf = [&](const Meshlet& m, int32_t (&c)[3]) {
+    auto p = (m.bounds.pos-minP)/cellSz;
+    c[0] = int32_t(p.x);
+    c[1] = int32_t(p.y);
+    c[2] = int32_t(p.z);
+    };
+  auto cellKey = [](int32_t x, int32_t y, int32_t z) {
+    return (uint64_t(uint32_t(x)&0x1FFFFF)<<42) | (uint64_t(uint32_t(y)&0x1FFFFF)<<21) | uint64_t(uint32_t(z)&0x1FFFFF);
+    };
+
+  std::unordered_map<uint64_t,std::vector<uint32_t>> grid;
+  std::vector<uint32_t>                              large;
+  for(size_t i=0; i<ind.size(); ++i) {
+    if(ind[i]->bounds.r>cellSz) {
+      large.push_back(uint32_t(i));
+      continue;
       }
-    sub.iboLength = indices.size()-sub.iboOffset;
-    if(sub.iboLength>0)
-      subMeshes.push_back(std::move(sub));
-    return;
+    int32_t c[3] = {};
+    cellOf(*ind[i],c);
+    grid[cellKey(c[0],c[1],c[2])].push_back(uint32_t(i));
     }
 
-  std::vector<Meshlet*> ind(meshlets.size());
+  std::vector<uint32_t> cand;
+  for(size_t i=0; i<ind.size(); ++i) {
+    auto mesh = ind[i];
+    if(mesh==nullptr)
+      continue;
+    if(mesh->indSz>=MaxInd-3 || mesh->vertSz>=MaxVert-3)
+      continue;
+
+    cand.clear();
+    if(mesh->bounds.r>cellSz) {
+      for(size_t r=i+1; r<ind.size(); ++r)
+        cand.push_back(uint32_t(r));
+      } else {
+      int32_t c[3] = {};
+      cellOf(*mesh,c);
+      for(int32_t x=c[0]-1; x<=c[0]+1; ++x)
+        for(int32_t y=c[1]-1; y<=c[1]+1; ++y)
+          for(int32_t z=c[2]-1; z<=c[2]+1; ++z) {
+            auto cell = grid.find(cellKey(x,y,z));
+            if(cell==grid.end())
+              continue;
+            for(auto r:cell->second)
+              if(r>i)
+                cand.push_back(r);
+            }
+      for(auto r:large)
+        if(r>i)
+          cand.push_back(r);
+      std::sort(cand.begin(),cand.end());
+      }
+
+    for(auto r:cand) {
+      if(ind[r]==nullptr)
+        continue;
+      if(!mesh->canMerge(*ind[r]))
+        continue;
+      float qDist = mesh->qDistance(*ind[r]);
+      float R     = (mesh->bounds.r+ind[r]->bounds.r)*0.5f;
+      if(qDist>(MergeDist*MergeDist) && qDist>R*R)
+        continue;
+      mesh->merge(*ind[r]);
+      ind[r] = nullptr;
+      }
+    }
+
+  size_t n = 0;
+  for(size_t i=0; i<ind.size();++i) {
+    if(ind[i]!=nullptr) {
+      ind[n] = ind[i];
+      ++n;
+      }
+    }
+  ind.resize(n);
+  }
+
+void PackedMesh::postProcessP1(const ZenLoad::zCMesh& mesh, std::vector<Meshlet>& meshlets,
+                               std::vector<Meshlet*>& ind) const {
+  ind.resize(meshlets.size());
   for(size_t i=0; i<meshlets.size(); ++i) {
     meshlets[i].updateBounds(mesh);
     ind[i] = &meshlets[i];
     }
+  if(ind.size()<=1)
+    return;
 
   // merge
   sortPass(ind);
@@ -657,10 +884,6 @@ void PackedMesh::postProcessP1(const ZenLoad::zCMesh& mesh, size_t matId, std::v
 
   for(auto i:ind)
     i->updateBounds(mesh);
-
-  postProcessP2(mesh,matId,ind);
-  // dbgUtilization(ind);
-  // dbgMeshlets(mesh,ind);
   }
 
 void PackedMesh::postProcessP2(const ZenLoad::zCMesh& mesh, size_t matId, std::vector<Meshlet*>& meshlets) {
@@ -753,6 +976,40 @@ void PackedMesh::dbgUtilization(const std::vector<Meshlet*>& meshlets) {
     Log::d("");
   }
 
+void PackedMesh::dbgVertexCache() const {
+  // FIFO post-transform cache simulation: ACMR - vertices per triangle, ATVR - vertices per unique vertex
+  for(size_t fifo:{16,32}) {
+    std::vector<uint32_t> cache(fifo,uint32_t(-1));
+    std::vector<bool>     used(vertices.size()+verticesA.size());
+    size_t transformed = 0, unique = 0, triangles = 0;
+    for(auto& s:subMeshes) {
+      size_t pos = 0;
+      std::fill(cache.begin(),cache.end(),uint32_t(-1));
+      for(size_t i=0; i<s.iboLength; i+=3) {
+        const uint32_t* tri = &indices[s.iboOffset+i];
+        if(tri[0]==tri[1] && tri[1]==tri[2])
+          continue; // padding
+        for(size_t r=0; r<3; ++r) {
+          if(std::find(cache.begin(),cache.end(),tri[r])!=cache.end())
+            continue;
+          cache[pos] = tri[r];
+          pos        = (pos+1)%fifo;
+          ++transformed;
+          if(!used[tri[r]]) {
+            used[tri[r]] = true;
+            ++unique;
+            }
+          }
+        ++triangles;
+        }
+      }
+    if(triangles==0)
+      return;
+    Log::d("Vertex cache [",fifo,"]: ACMR = ",float(transformed)/float(triangles),
+           ", ATVR = ",float(transformed)/float(unique));
+    }
+  }
+
 void PackedMesh::dbgMeshlets(const ZenLoad::zCMesh& mesh, const std::vector<Meshlet*>& meshlets) {
   std::ofstream out("dbg.obj");
 
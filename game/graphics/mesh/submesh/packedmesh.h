@@ -25,6 +25,10 @@ class PackedMesh {
       // NVidia allocates pipeline memory in batches of 128 bytes (4 reserved for size)
       MaxInd      = 41*3,
       MaxMeshlets = 16,
+      // meshlets closer than that are merged
+      MergeDist   = 500,
+      // simulated post-transform cache, for triangle ordering
+      CacheSize   = 32,
       };
 
     enum PkgType {
@@ -90,6 +94,7 @@ class PackedMesh {
 
       bool    insert(const Vert& a, const Vert& b, const Vert& c, uint8_t matchHint);
       void    clear();
+      void    optimizeOrder();
       void    updateBounds(const ZenLoad::zCMesh& mesh);
       void    updateBounds(const ZenLoad::zCProgMeshProto& mesh);
       void    updateBounds(const std::vector<ZMath::float3>& vbo);
@@ -101,20 +106,22 @@ class PackedMesh {
 
     void   addIndex(Meshlet* active, size_t numActive, std::vector<Meshlet>& meshlets,
                     const Vert& a, const Vert& b, const Vert& c);
-    void   packMeshlets(const ZenLoad::zCMesh& mesh);
+    void   packMeshlets(const ZenLoad::zCMesh& mesh, bool parallel);
     void   packMeshlets(const ZenLoad::zCProgMeshProto& mesh, PkgType type,
                         const std::vector<SkeletalData>* skeletal);
 
-    void   postProcessP1(const ZenLoad::zCMesh& mesh, size_t matId, std::vector<Meshlet>& meshlets);
+    void   postProcessP1(const ZenLoad::zCMesh& mesh, std::vector<Meshlet>& meshlets, std::vector<Meshlet*>& ind) const;
     void   postProcessP2(const ZenLoad::zCMesh& mesh, size_t matId, std::vector<Meshlet*>& meshlets);
 
-    void   sortPass(std::vector<Meshlet*>& meshlets);
-    void   mergePass(std::vector<Meshlet*>& meshlets, bool fast);
+    void   sortPass(std::vector<Meshlet*>& meshlets) const;
+    void   mergePass(std::vector<Meshlet*>& meshlets, bool fast) const;
+    void   mergePassGrid(std::vector<Meshlet*>& meshlets) const;
 
     void   packPhysics(const ZenLoad::zCMesh& mesh,PkgType type);
     void   computeBbox();
 
     void   dbgUtilization(const std::vector<Meshlet*>& meshlets);
+    void   dbgVertexCache() const;
     void   dbgMeshlets(const ZenLoad::zCMesh& mesh, const std::vector<Meshlet*>& meshlets);
   };
 
@@ -73,6 +73,13 @@ bool PfxBucket::isEmpty() const {
   return impl.size()==0;
   }
 
+size_t PfxBucket::memoryUsage() const {
+  return vboCpu.capacity()*sizeof(Vertex) +
+         particles.capacity()*sizeof(ParState) +
+         impl.capacity()*sizeof(ImplEmitter) +
+         block.capacity()*sizeof(Block);
+  }
+
 size_t PfxBucket::allocBlock() {
   for(size_t i=0;i<block.size();++i) {
     if(!block[i].allocated) {
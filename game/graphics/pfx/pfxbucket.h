@@ -50,6 +50,7 @@ class PfxBucket {
     size_t                      blockSize = 0;
 
     bool                        isEmpty() const;
+    size_t                      memoryUsage() const;
 
     size_t                      allocEmitter();
     void                        freeEmitter(size_t& id);
@@ -10,6 +10,7 @@
 #include "graphics/sceneglobals.h"
 #include "graphics/lightsource.h"
 #include "world/world.h"
+#include "utils/memoryreport.h"
 
 #include "pfxbucket.h"
 #include "particlefx.h"
@@ -86,6 +87,14 @@ bool PfxObjects::isInPfxRange(const Vec3& pos) const {
   return dp.quadLength()<viewRage*viewRage;
   }
 
+void PfxObjects::memoryUsage(MemoryReport& rep) {
+  std::lock_guard<std::recursive_mutex> guard(sync);
+  size_t bytes = 0;
+  for(auto& i:bucket)
+    bytes += i.memoryUsage();
+  rep.add("particles",bucket.size(),bytes);
+  }
+
 void PfxObjects::preFrameUpdate(uint8_t fId) {
   for(auto i=bucket.begin(), end = bucket.end(); i!=end; ) {
     if(i->isEmpty()) {
@@ -15,6 +15,7 @@ class SceneGlobals;
 class ParticleFx;
 class PfxBucket;
 class WorldView;
+class MemoryReport;
 
 class PfxObjects final {
   public:
@@ -41,6 +42,7 @@ class PfxObjects final {
     bool       isInPfxRange(const Tempest::Vec3& pos) const;
 
     void       preFrameUpdate(uint8_t fId);
+    void       memoryUsage(MemoryReport& rep);
 
   private:
     struct SpriteEmitter {
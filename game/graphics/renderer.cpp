@@ -5,6 +5,7 @@
 #include <Tempest/Log>
 
 #include "ui/inventorymenu.h"
+#include "utils/frameprofiler.h"
 #include "camera.h"
 #include "gothic.h"
 
@@ -203,6 +204,7 @@ void Renderer::prepareUniforms() {
 void Renderer::draw(Encoder<CommandBuffer>& cmd, uint8_t cmdId, size_t imgId,
                     VectorImage::Mesh& uiLayer, VectorImage::Mesh& numOverlay,
                     InventoryMenu& inventory) {
+  FrameProfiler::Zone zone("Renderer::draw");
   auto& result = swapchain[imgId];
 
   draw(result, cmd, cmdId);
@@ -157,6 +157,8 @@ Shaders::Shaders() {
 
     lndPrePass = device.pipeline(Triangles,state,ms,fs);
     }
+
+  mkMaterialPipelines();
   }
 
 Shaders::~Shaders() {
@@ -169,12 +171,37 @@ Shaders& Shaders::inst() {
 
 const RenderPipeline* Shaders::materialPipeline(const Material& mat, ObjectsBucket::Type t, PipelineType pt) const {
   const auto alpha = (mat.isGhost ? Material::Ghost : mat.alpha);
+  auto&      e     = materials[alpha][t][pt];
+  return e.valid ? &e.pipeline : nullptr;
+  }
 
-  for(auto& i:materials) {
-    if(i.alpha==alpha && i.type==t && i.pipelineType==pt)
-      return &i.pipeline;
-    }
+bool Shaders::isReachable(Material::AlphaFunc alpha, ObjectsBucket::Type t) {
+  // landscape shadow-bucket is created only with solid material
+  if(t==ObjectsBucket::LandscapeShadow)
+    return alpha==Material::Solid;
+  // water landscape is moved into static bucket, see ObjectsBucket::sanitizeType
+  if(t==ObjectsBucket::Landscape && alpha==Material::Water)
+    return false;
+  // ghost is applied only to npc meshes and attachments
+  if(alpha==Material::Ghost)
+    return t!=ObjectsBucket::Landscape && t!=ObjectsBucket::Pfx;
+  return true;
+  }
 
+void Shaders::mkMaterialPipelines() {
+  // all reachable combinations are known upfront: lookup at draw-time is lock-free
+  for(uint8_t alpha=0; alpha<AlphaCount; ++alpha)
+    for(uint8_t t=0; t<TypeCount; ++t) {
+      if(!isReachable(Material::AlphaFunc(alpha),ObjectsBucket::Type(t)))
+        continue;
+      for(uint8_t pt=0; pt<PipelineCount; ++pt) {
+        auto& e = materials[alpha][t][pt];
+        e.valid = mkMaterialPipeline(e,Material::AlphaFunc(alpha),ObjectsBucket::Type(t),PipelineType(pt));
+        }
+      }
+  }
+
+bool Shaders::mkMaterialPipeline(Entry& b, Material::AlphaFunc alpha, ObjectsBucket::Type t, PipelineType pt) const {
   const MaterialTemplate* forward  = nullptr;
   const MaterialTemplate* deffered = nullptr;
   const MaterialTemplate* shadow   = nullptr;
@@ -254,13 +281,8 @@ const RenderPipeline* Shaders::materialPipeline(const Material& mat, ObjectsBuck
     }
 
   if(temp==nullptr)
-    return nullptr;
+    return false;
 
-  materials.emplace_front();
-  auto& b = materials.front();
-  b.alpha        = alpha;
-  b.type         = t;
-  b.pipelineType = pt;
   switch(t) {
     case ObjectsBucket::Landscape:
     case ObjectsBucket::LandscapeShadow:
@@ -280,8 +302,7 @@ const RenderPipeline* Shaders::materialPipeline(const Material& mat, ObjectsBuck
       b.pipeline = pipeline(state,temp->pfx);
       break;
     }
-
-  return &b.pipeline;
+  return true;
   }
 
 RenderPipeline Shaders::postEffect(std::string_view name) {
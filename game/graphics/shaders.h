@@ -55,13 +55,20 @@ class Shaders {
       void load(Tempest::Device& device, const char* tag, bool hasTesselation=false, bool hasMeshlets=false);
       };
 
+    enum {
+      AlphaCount    = Material::Multiply2+1,
+      TypeCount     = ObjectsBucket::Morph+1,
+      PipelineCount = T_Shadow+1,
+      };
+
     struct Entry {
       Tempest::RenderPipeline pipeline;
-      Material::AlphaFunc     alpha        = Material::Solid;
-      ObjectsBucket::Type     type         = ObjectsBucket::Static;
-      PipelineType            pipelineType = PipelineType::T_Forward;
+      bool                    valid = false;
       };
 
+    static bool              isReachable(Material::AlphaFunc alpha, ObjectsBucket::Type t);
+    void                     mkMaterialPipelines();
+    bool                     mkMaterialPipeline(Entry& e, Material::AlphaFunc alpha, ObjectsBucket::Type t, PipelineType pt) const;
     Tempest::RenderPipeline  pipeline(Tempest::RenderState& st, const ShaderSet &fs) const;
     Tempest::RenderPipeline  postEffect(std::string_view name);
     Tempest::ComputePipeline computeShader(std::string_view name);
@@ -72,5 +79,5 @@ class Shaders {
 
     MaterialTemplate solid,  atest, solidF, atestF, water, ghost, emmision;
     MaterialTemplate shadow, shadowAt;
-    mutable std::list<Entry> materials;
+    Entry                    materials[AlphaCount][TypeCount][PipelineCount];
   };
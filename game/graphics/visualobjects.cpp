@@ -5,6 +5,7 @@
 #include "graphics/mesh/submesh/animmesh.h"
 #include "worldview.h"
 #include "utils/workers.h"
+#include "utils/memoryreport.h"
 #include "gothic.h"
 
 using namespace Tempest;
@@ -233,6 +234,15 @@ void VisualObjects::mkIndex() {
   */
   }
 
+void VisualObjects::dbgSkinning(DbgPainter& p) const {
+  matrix.dbgDraw(p);
+  }
+
+void VisualObjects::memoryUsage(MemoryReport& rep) const {
+  auto st = matrix.stats();
+  rep.add("matrices",1,st.usedBytes+st.freeBytes);
+  }
+
 void VisualObjects::commitUbo(uint8_t fId) {
   bool sk = matrix.commit(fId);
   if(!sk)
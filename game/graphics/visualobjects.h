@@ -8,6 +8,8 @@ class SceneGlobals;
 class Bindless;
 class AnimMesh;
 class Sky;
+class DbgPainter;
+class MemoryReport;
 
 class VisualObjects final {
   public:
@@ -43,6 +45,8 @@ class VisualObjects final {
     void recycle(Tempest::DescriptorSet&& del);
 
     void updateTlas(Bindless& out, uint8_t fId);
+    void dbgSkinning(DbgPainter& p) const;
+    void memoryUsage(MemoryReport& rep) const;
 
     void setLandscapeBlas(const Tempest::AccelerationStructure* blas);
     Tempest::Signal<void(const Tempest::AccelerationStructure* tlas)> onTlasChanged;
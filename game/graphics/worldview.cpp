@@ -42,6 +42,11 @@ bool WorldView::isInPfxRange(const Vec3& pos) const {
   return pfxGroup.isInPfxRange(pos);
   }
 
+void WorldView::memoryUsage(MemoryReport& rep) {
+  visuals .memoryUsage(rep);
+  pfxGroup.memoryUsage(rep);
+  }
+
 void WorldView::tick(uint64_t /*dt*/) {
   auto pl = owner.player();
   if(pl!=nullptr) {
@@ -95,6 +100,10 @@ void WorldView::dbgLights(DbgPainter& p) const {
   sGlobal.lights.dbgLights(p);
   }
 
+void WorldView::dbgSkinning(DbgPainter& p) const {
+  visuals.dbgSkinning(p);
+  }
+
 void WorldView::prepareSky(Tempest::Encoder<Tempest::CommandBuffer>& cmd, uint8_t frameId) {
   sky.prepareSky(cmd,frameId);
   }
@@ -17,6 +17,7 @@
 class World;
 class ParticleFx;
 class PackedMesh;
+class MemoryReport;
 
 class WorldView {
   public:
@@ -28,6 +29,7 @@ class WorldView {
     const Tempest::Vec3&      ambientLight() const;
 
     bool isInPfxRange(const Tempest::Vec3& pos) const;
+    auto mainFrustrum() const -> const Frustrum& { return sGlobal.frustrum[SceneGlobals::V_Main]; }
 
     void tick(uint64_t dt);
 
@@ -43,6 +45,8 @@ class WorldView {
     void setupTlas(const Tempest::AccelerationStructure* tlas);
 
     void dbgLights    (DbgPainter& p) const;
+    void dbgSkinning  (DbgPainter& p) const;
+    void memoryUsage  (MemoryReport& rep);
     void prepareSky   (Tempest::Encoder<Tempest::CommandBuffer> &cmd, uint8_t frameId);
     void updateLight();
 
@@ -13,6 +13,7 @@
 #endif
 
 #include "utils/crashlog.h"
+#include "utils/frameprofiler.h"
 #include "mainwindow.h"
 #include "gothic.h"
 #include "build.h"
@@ -77,6 +78,8 @@ int main(int argc,const char** argv) {
   Tempest::Log::i(appBuild);
 
   CommandLine          cmd{argc,argv};
+  if(cmd.doProfile())
+    FrameProfiler::setEnabled(true);
   auto                 api = mkApi(cmd);
 
   Tempest::Device      device{*api,selectDevice(*api)};
@@ -88,5 +91,8 @@ int main(int argc,const char** argv) {
 
   MainWindow           wx(device);
   Tempest::Application app;
-  return app.exec();
+  const int ret = app.exec();
+  if(FrameProfiler::isEnabled() && !FrameProfiler::dump("frameprofile.json"))
+    Tempest::Log::e("unable to write frameprofile.json");
+  return ret;
   }
@@ -218,6 +218,16 @@ void MainWindow::paintEvent(PaintEvent& event) {
       }
 
     // world->view()->dbgLights(dbg);
+    if(world!=nullptr && c->isDebug())
+      world->view()->dbgSkinning(dbg);
+    if(c->isDebug()) {
+      auto st  = Resources::font().stats();
+      auto cnt = st.hits+st.misses;
+      char buf[128]={};
+      std::snprintf(buf,sizeof(buf),"text layouts: %d cached, hit rate %d%%",
+                    int(st.entries),int(cnt>0 ? st.hits*100/cnt : 0));
+      dbg.drawText(10,50+3*Resources::font().pixelSize(),buf);
+      }
     }
 
   renderer.dbgDraw(p);
@@ -713,6 +723,7 @@ void MainWindow::onMarvinKey() {
   }
 
 uint64_t MainWindow::tick() {
+  FrameProfiler::Zone zone("MainWindow::tick");
   auto time = Application::tickCount();
   auto dt   = time-lastTick;
   // NOTE: limit to ~200 FPS in game logic to avoid math issues
@@ -764,6 +775,63 @@ uint64_t MainWindow::tick() {
   return dt;
   }
 
+void MainWindow::tickBenchmark() {
+  // simulation only: no input, no camera, no gpu work; fixed time step keeps runs comparable
+  auto st = Gothic::inst().checkLoading();
+  if(st!=Gothic::LoadState::Idle) {
+    if(Gothic::inst().finishLoading() && st!=Gothic::LoadState::Finalize) {
+      Log::e("benchmark: unable to load the world");
+      SystemApi::exit();
+      }
+    return;
+    }
+
+  const uint64_t dt  = 1000/60;
+  const uint64_t end = uint64_t(CommandLine::inst().benchmarkTime())*60*1000;
+  if(!Gothic::inst().isInGame() || bench.simTime>=end)
+    return;
+
+  if(bench.simTime==0) {
+    Log::i("benchmark: ",CommandLine::inst().benchmarkTime()," simulated minutes");
+    FrameProfiler::setEnabled(true);
+    FrameProfiler::collect(bench.stat); // drop events recorded before start
+    bench.stat.clear();
+    bench.wallStart = Application::tickCount();
+    }
+
+  {
+  FrameProfiler::Zone zone("Benchmark::frame");
+  Gothic::inst().tick(dt);
+  Gothic::inst().updateAnimation(dt);
+  }
+  bench.simTime += dt;
+  FrameProfiler::collect(bench.stat);
+
+  if(bench.simTime<end)
+    return;
+
+  const uint64_t wall   = Application::tickCount()-bench.wallStart;
+  const uint64_t frames = bench.simTime/dt;
+  std::sort(bench.stat.begin(),bench.stat.end(),[](const FrameProfiler::Stat& l, const FrameProfiler::Stat& r){
+    return l.total>r.total;
+    });
+
+  char buf[256] = {};
+  std::snprintf(buf,sizeof(buf),"benchmark: %llu frames in %llu ms",
+                static_cast<unsigned long long>(frames), static_cast<unsigned long long>(wall));
+  Log::i(buf);
+  for(auto& i:bench.stat) {
+    std::snprintf(buf,sizeof(buf),"  %-28s total = %10.2f ms, per frame = %7.3f ms, calls = %llu",
+                  i.name, double(i.total)/1000000.0, double(i.total)/1000000.0/double(frames),
+                  static_cast<unsigned long long>(i.calls));
+    Log::i(buf);
+    }
+
+  if(!CommandLine::inst().doProfile())
+    FrameProfiler::setEnabled(false);
+  SystemApi::exit();
+  }
+
 void MainWindow::tickCamera(uint64_t dt) {
   auto pcamera = Gothic::inst().camera();
   auto pl      = Gothic::inst().player();
@@ -968,6 +1036,12 @@ void MainWindow::setFullscreen(bool fs) {
   }
 
 void MainWindow::render(){
+  if(CommandLine::inst().benchmarkTime()>0) {
+    tickBenchmark();
+    return;
+    }
+
+  FrameProfiler::Zone zone("MainWindow::render");
   try {
     static uint64_t time=Application::tickCount();
 
@@ -37,6 +37,7 @@
 #include "ui/consolewidget.h"
 
 #include "utils/keycodec.h"
+#include "utils/frameprofiler.h"
 #include "resources.h"
 
 class MenuRoot;
@@ -93,6 +94,7 @@ class MainWindow : public Tempest::Window {
 
     uint64_t tick();
     void     tickCamera(uint64_t dt);
+    void     tickBenchmark();
     void     isDialogClosed(bool& ret);
 
     template<Tempest::KeyEvent::KeyType k>
@@ -162,4 +164,11 @@ class MainWindow : public Tempest::Window {
       };
     Fps        fps;
     uint64_t   maxFpsInv = 0;
+
+    struct Benchmark {
+      uint64_t                         simTime   = 0;
+      uint64_t                         wallStart = 0;
+      std::vector<FrameProfiler::Stat> stat;
+      };
+    Benchmark  bench;
   };
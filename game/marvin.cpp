@@ -3,8 +3,12 @@
 #include <initializer_list>
 #include <cstdint>
 #include <cctype>
+#include <chrono>
 
 #include "world/objects/npc.h"
+#include "utils/frameprofiler.h"
+#include "utils/memoryreport.h"
+#include "game/compatibility/mem32.h"
 #include "camera.h"
 #include "gothic.h"
 
@@ -117,6 +121,12 @@ Marvin::Marvin() {
     {"toogle camdebug",   C_ToogleCamDebug},
     {"toogle camera",     C_ToogleCamera},
     {"insert %c",         C_Insert},
+
+    {"toogle scriptprofile",  C_ToogleScriptProfile},
+    {"dump scriptprofile",    C_DumpScriptProfile},
+    {"toogle frameprofile",   C_ToogleFrameProfile},
+    {"print memory",          C_PrintMemory},
+    {"benchmark mem_readint", C_BenchmarkMemRead},
     };
   }
 
@@ -264,6 +274,41 @@ bool Marvin::exec(const std::string& v) {
         return false;
       return printVariable(world,ret.argv[0]);
       }
+    case C_ToogleScriptProfile: {
+      World* world = Gothic::inst().world();
+      if(world==nullptr)
+        return false;
+      auto& sc = world->script();
+      sc.setProfiling(!sc.isProfiling());
+      print(sc.isProfiling() ? "script profiling: on" : "script profiling: off");
+      return true;
+      }
+    case C_DumpScriptProfile: {
+      World* world = Gothic::inst().world();
+      if(world==nullptr)
+        return false;
+      return dumpScriptProfile(world);
+      }
+    case C_ToogleFrameProfile: {
+      if(!FrameProfiler::isEnabled()) {
+        FrameProfiler::setEnabled(true);
+        print("frame profiling: on");
+        return true;
+        }
+      // dump stops capture and waits for zones that are still being recorded
+      if(!FrameProfiler::dump("frameprofile.json"))
+        return false;
+      print("written to frameprofile.json");
+      return true;
+      }
+    case C_PrintMemory: {
+      MemoryReport rep;
+      Gothic::inst().memoryUsage(rep);
+      rep.print([this](std::string_view s){ print(s); });
+      return true;
+      }
+    case C_BenchmarkMemRead:
+      return benchmarkMemRead();
     }
 
   return true;
@@ -316,6 +361,60 @@ bool Marvin::printVariable(World* world, std::string_view name) {
   return true;
   }
 
+bool Marvin::dumpScriptProfile(World* world) {
+  auto& sc = world->script();
+  if(!sc.dumpProfile("scriptprofile.folded"))
+    return false;
+
+  char buf[256] = {};
+  for(auto& i:sc.profileHotList(10)) {
+    auto& sym = sc.getSymbol(i.fn);
+    std::snprintf(buf,sizeof(buf),"%s: calls = %llu, incl = %.2f ms, excl = %.2f ms",
+                  sym.name.c_str(), static_cast<unsigned long long>(i.calls),
+                  double(i.inclusive)/1000000.0, double(i.exclusive)/1000000.0);
+    print(buf);
+    }
+  print("written to scriptprofile.folded");
+  return true;
+  }
+
+bool Marvin::benchmarkMemRead() {
+  // same access pattern as Ikarus/LeGo loops: many small blocks, int-sized reads
+  enum {
+    BlockCount = 4096,
+    BlockSize  = 64,
+    ReadCount  = 1<<22,
+    };
+  Mem32                       mem;
+  std::vector<Mem32::ptr32_t> blocks(BlockCount);
+  for(auto& b:blocks)
+    b = mem.alloc(BlockSize);
+
+  auto bench = [&](const char* name, auto addr) {
+    int32_t sum = 0;
+    auto    t0  = std::chrono::high_resolution_clock::now();
+    for(uint32_t i=0; i<ReadCount; ++i)
+      sum += mem.readInt(addr(i));
+    auto    t1  = std::chrono::high_resolution_clock::now();
+    auto    ns  = std::chrono::duration_cast<std::chrono::nanoseconds>(t1-t0).count();
+
+    char buf[256] = {};
+    std::snprintf(buf,sizeof(buf),"%s: %.2f ns/read (%d)",name,double(ns)/ReadCount,int(sum));
+    print(buf);
+    };
+
+  bench("MEM_ReadInt, same block", [&](uint32_t i) {
+    return blocks[0] + (i%(BlockSize/4))*4;
+    });
+  bench("MEM_ReadInt, scattered",  [&](uint32_t i) {
+    return blocks[(i*2654435761u)%BlockCount] + (i%(BlockSize/4))*4;
+    });
+
+  for(auto b:blocks)
+    mem.free(b);
+  return true;
+  }
+
 std::string_view Marvin::completeInstanceName(std::string_view inp, bool& fullword) const {
   World* world  = Gothic::inst().world();
   if(world==nullptr || inp.size()==0)
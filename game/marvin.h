@@ -34,6 +34,13 @@ class Marvin {
       C_ToogleCamera,
 
       C_Insert,
+
+      // script
+      C_ToogleScriptProfile,
+      C_DumpScriptProfile,
+      C_ToogleFrameProfile,
+      C_PrintMemory,
+      C_BenchmarkMemRead,
       };
 
     struct Cmd {
@@ -59,6 +66,8 @@ class Marvin {
 
     bool   addItemOrNpcBySymbolName(World* world, std::string_view name, const Tempest::Vec3& at);
     bool   printVariable           (World* world, std::string_view name);
+    bool   dumpScriptProfile       (World* world);
+    bool   benchmarkMemRead        ();
 
     std::vector<Cmd> cmd;
   };
@@ -245,6 +245,19 @@ void CollisionWorld::rayCast(const Tempest::Vec3& b, const Tempest::Vec3& e, btC
   this->rayTest(s,f,cb);
   }
 
+void CollisionWorld::sphereCast(const Tempest::Vec3& b, const Tempest::Vec3& e, float R, btCollisionWorld::ConvexResultCallback& cb) {
+  btVector3 s = toMeters(b), f = toMeters(e);
+  if(s==f)
+    return;
+  btSphereShape sphere(R*0.01f);
+  btTransform   from, to;
+  from.setIdentity();
+  from.setOrigin(s);
+  to.setIdentity();
+  to.setOrigin(f);
+  this->convexSweepTest(&sphere,from,to,cb);
+  }
+
 void CollisionWorld::tick(uint64_t dt) {
   static bool  dynamic = true;
   const  float dtF     = float(dt);
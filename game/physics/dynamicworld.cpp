@@ -12,6 +12,8 @@
 #include "world/objects/item.h"
 #include "world/bullet.h"
 #include "world/world.h"
+#include "utils/frameprofiler.h"
+#include "utils/memoryreport.h"
 
 const float DynamicWorld::ghostPadding=50-22.5f;
 const float DynamicWorld::ghostHeight =140;
@@ -467,6 +469,15 @@ DynamicWorld::DynamicWorld(World& owner,const ZenLoad::zCMesh& worldMesh) {
 DynamicWorld::~DynamicWorld(){
   }
 
+void DynamicWorld::memoryUsage(MemoryReport& rep) const {
+  size_t bytes = landVbo.capacity()*sizeof(btVector3);
+  if(landMesh!=nullptr)
+    bytes += landMesh->memoryUsage();
+  if(waterMesh!=nullptr)
+    bytes += waterMesh->memoryUsage();
+  rep.add("physics meshes",2,bytes);
+  }
+
 DynamicWorld::RayLandResult DynamicWorld::landRay(const Tempest::Vec3& from, float maxDy) const {
   world->updateAabbs();
   if(maxDy==0)
@@ -576,6 +587,51 @@ DynamicWorld::RayLandResult DynamicWorld::ray(const Tempest::Vec3& from, const T
   return ret;
   }
 
+DynamicWorld::RayLandResult DynamicWorld::sphereCast(const Tempest::Vec3& from, const Tempest::Vec3& to, float R) const {
+  struct CallBack:btCollisionWorld::ClosestConvexResultCallback {
+    using ClosestConvexResultCallback::ClosestConvexResultCallback;
+
+    bool needsCollision(btBroadphaseProxy* proxy0) const override {
+      auto obj=reinterpret_cast<btCollisionObject*>(proxy0->m_clientObject);
+      if(obj->getUserIndex()==C_Landscape || obj->getUserIndex()==C_Object)
+        return ClosestConvexResultCallback::needsCollision(proxy0);
+      return false;
+      }
+
+    btScalar addSingleResult(btCollisionWorld::LocalConvexResult& convexResult, bool normalInWorldSpace) override {
+      // same as kF_FilterBackfaces in ray(): sweep passes through triangles from behind
+      auto info  = convexResult.m_localShapeInfo;
+      auto obj   = convexResult.m_hitCollisionObject;
+      auto shape = obj->getCollisionShape();
+      if(info!=nullptr && shape!=nullptr) {
+        auto s  = reinterpret_cast<const btMultimaterialTriangleMeshShape*>(shape);
+        auto mt = reinterpret_cast<const PhysicVbo*>(s->getMeshInterface());
+        auto n  = mt->triangleNormal(size_t(info->m_shapePart),size_t(info->m_triangleIndex));
+        n = obj->getWorldTransform().getBasis()*n;
+        if(n.dot(m_convexToWorld-m_convexFromWorld)>=0)
+          return m_closestHitFraction;
+        }
+      return ClosestConvexResultCallback::addSingleResult(convexResult,normalInWorldSpace);
+      }
+    };
+
+  CallBack callback{CollisionWorld::toMeters(from), CollisionWorld::toMeters(to)};
+  world->sphereCast(from,to,R,callback);
+
+  RayLandResult ret;
+  ret.v           = to;
+  ret.hasCol      = callback.hasHit();
+  ret.hitFraction = callback.m_closestHitFraction;
+  if(callback.hasHit()) {
+    // center of the sphere at time of impact
+    ret.v   = from + (to-from)*callback.m_closestHitFraction;
+    ret.n.x = callback.m_hitNormalWorld.x();
+    ret.n.y = callback.m_hitNormalWorld.y();
+    ret.n.z = callback.m_hitNormalWorld.z();
+    }
+  return ret;
+  }
+
 DynamicWorld::RayQueryResult DynamicWorld::rayNpc(const Tempest::Vec3& from, const Tempest::Vec3& to) const {
   RayQueryResult r;
   static_cast<RayLandResult&>(r) = ray(from,to);
@@ -793,6 +849,7 @@ void DynamicWorld::moveBullet(BulletBody &b, const Tempest::Vec3& dir, uint64_t
   }
 
 void DynamicWorld::tick(uint64_t dt) {
+  FrameProfiler::Zone zone("DynamicWorld::tick");
   npcList   ->tickAabbs();
   bulletList->tick(dt);
   world     ->tick(dt);
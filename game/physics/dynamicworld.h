@@ -25,6 +25,7 @@ class Item;
 class Interactive;
 
 class CollisionWorld;
+class MemoryReport;
 
 class DynamicWorld final {
   private:
@@ -228,10 +229,13 @@ class DynamicWorld final {
       friend class DynamicWorld;
       };
 
+    void           memoryUsage(MemoryReport& rep) const;
+
     RayLandResult  landRay      (const Tempest::Vec3& from, float maxDy=0) const;
     RayWaterResult waterRay     (const Tempest::Vec3& from) const;
 
     RayLandResult  ray          (const Tempest::Vec3& from, const Tempest::Vec3& to) const;
+    RayLandResult  sphereCast   (const Tempest::Vec3& from, const Tempest::Vec3& to, float R) const;
     RayQueryResult rayNpc       (const Tempest::Vec3& from, const Tempest::Vec3& to) const;
     float          soundOclusion(const Tempest::Vec3& from, const Tempest::Vec3& to) const;
 
@@ -83,6 +83,15 @@ const char* PhysicVbo::sectorName(size_t segment) const {
   return nullptr;
   }
 
+btVector3 PhysicVbo::triangleNormal(size_t segment, size_t triangle) const {
+  if(segment>=segments.size() || triangle>=size_t(segments[segment].size))
+    return btVector3(0,0,0);
+  // same winding as btTriangleRaycastCallback
+  const uint32_t* i = &id[segments[segment].off + triangle*3];
+  const btVector3& a = vert[i[0]];
+  return (vert[i[1]]-a).cross(vert[i[2]]-a);
+  }
+
 bool PhysicVbo::useQuantization() const {
   constexpr int maxParts = (1<<MAX_NUM_PARTS_IN_BITS);
   constexpr int maxTri   = (1 << (31 - MAX_NUM_PARTS_IN_BITS));
@@ -98,6 +107,12 @@ bool PhysicVbo::isEmpty() const {
   return segments.size()==0;
   }
 
+size_t PhysicVbo::memoryUsage() const {
+  return vStorage.capacity()*sizeof(btVector3) +
+         id.capacity()*sizeof(uint32_t) +
+         segments.capacity()*sizeof(Segment);
+  }
+
 void PhysicVbo::adjustMesh(){
   for(int i=0;i<m_indexedMeshes.size();++i) {
     btIndexedMesh& meshIndex=m_indexedMeshes[i];
@@ -23,8 +23,10 @@ class PhysicVbo : public btTriangleIndexVertexArray {
     void    addIndex(const std::vector<uint32_t>& index, size_t iboOff, size_t iboLen, uint8_t material, const char* sector);
     uint8_t materialId(size_t segment) const;
     auto    sectorName(size_t segment) const -> const char*;
+    auto    triangleNormal(size_t segment, size_t triangle) const -> btVector3;
     bool    useQuantization() const;
     bool    isEmpty() const;
+    size_t  memoryUsage() const;
 
     void    adjustMesh();
 
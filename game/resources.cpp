@@ -33,6 +33,7 @@
 #include "dmusic/directmusic.h"
 #include "utils/fileext.h"
 #include "utils/gthfont.h"
+#include "utils/memoryreport.h"
 
 #include "gothic.h"
 
@@ -144,6 +145,49 @@ Resources::~Resources() {
   inst=nullptr;
   }
 
+size_t Resources::textureSize(const Texture2d& t) {
+  size_t sz = size_t(t.w())*size_t(t.h());
+  switch(t.format()) {
+    case TextureFormat::DXT1:
+      sz = sz/2;
+      break;
+    case TextureFormat::DXT3:
+    case TextureFormat::DXT5:
+      break;
+    default:
+      sz = sz*4;
+      break;
+    }
+  // assume full mip chain
+  return sz*4/3;
+  }
+
+void Resources::memoryUsage(MemoryReport& rep) {
+  std::lock_guard<std::recursive_mutex> g(inst->sync);
+
+  size_t texBytes = 0;
+  for(auto& i:inst->texCache)
+    if(i.second!=nullptr)
+      texBytes += textureSize(*i.second);
+  rep.addGpu("textures",inst->texCache.size(),texBytes);
+  rep.addGpuCreated("vbo", inst->gpuVbo.count.load(), inst->gpuVbo.bytes.load());
+  rep.addGpuCreated("ibo", inst->gpuIbo.count.load(), inst->gpuIbo.bytes.load());
+  rep.addGpuCreated("ssbo",inst->gpuSsbo.count.load(),inst->gpuSsbo.bytes.load());
+
+  size_t aniBytes = 0;
+  for(auto& i:inst->animCache)
+    if(i.second!=nullptr)
+      aniBytes += i.second->memoryUsage();
+  rep.add("animations",inst->animCache.size(),aniBytes);
+
+  rep.add("meshes",      inst->aniMeshCache.size()+inst->decalMeshCache.size(),0);
+  rep.add("emiter meshes",inst->emiMeshCache.size(),0);
+  rep.add("skeletons",   inst->skeletonCache.size(),0);
+  rep.add("fonts",       inst->gothicFnt.size(),0);
+  rep.add("vob bundles", inst->zenCache.size(),0);
+  rep.add("file buffers",2,inst->fBuff.capacity()+inst->ddsBuf.capacity());
+  }
+
 bool Resources::hasFile(std::string_view name) {
   std::lock_guard<std::recursive_mutex> g(inst->sync);
   if(name.size()<128) {
@@ -709,6 +753,12 @@ Dx8::PatternList Resources::loadDxMusic(std::string_view name) {
   return inst->implLoadDxMusic(name);
   }
 
+uint64_t Resources::dxMusicHash(std::string_view name) {
+  std::lock_guard<std::recursive_mutex> g(inst->sync);
+  auto u = Tempest::TextCodec::toUtf16(std::string(name));
+  return inst->dxMusic->fileHash(u.c_str());
+  }
+
 const ProtoMesh* Resources::decalMesh(const ZenLoad::zCVobData& vob) {
   std::lock_guard<std::recursive_mutex> g(inst->sync);
   return inst->implDecalMesh(vob);
@@ -11,6 +11,7 @@
 #include <zenload/zCMorphMesh.h>
 #include <zenload/zTypes.h>
 
+#include <atomic>
 #include <tuple>
 #include <string_view>
 
@@ -26,6 +27,7 @@ class PhysicMeshShape;
 class PfxEmitterMesh;
 class SoundFx;
 class GthFont;
+class MemoryReport;
 
 namespace Dx8 {
 class DirectMusic;
@@ -106,17 +108,18 @@ class Resources final {
     static Tempest::Sound            loadSoundBuffer(std::string_view name);
 
     static Dx8::PatternList          loadDxMusic(std::string_view name);
+    static uint64_t                  dxMusicHash(std::string_view name);
     static const ProtoMesh*          decalMesh(const ZenLoad::zCVobData& vob);
 
     static ZenLoad::oCWorldData      loadVobBundle(std::string_view name);
 
     template<class V>
-    static Tempest::VertexBuffer<V>  vbo(const V* data,size_t sz){ return inst->dev.vbo(data,sz); }
+    static Tempest::VertexBuffer<V>  vbo(const V* data,size_t sz){ inst->gpuVbo.add(sz*sizeof(V)); return inst->dev.vbo(data,sz); }
 
     template<class V>
-    static Tempest::IndexBuffer<V>   ibo(const V* data,size_t sz){ return inst->dev.ibo(data,sz); }
+    static Tempest::IndexBuffer<V>   ibo(const V* data,size_t sz){ inst->gpuIbo.add(sz*sizeof(V)); return inst->dev.ibo(data,sz); }
 
-    static Tempest::StorageBuffer    ssbo(const void* data, size_t size) { return inst->dev.ssbo(data,size); }
+    static Tempest::StorageBuffer    ssbo(const void* data, size_t size) { inst->gpuSsbo.add(size); return inst->dev.ssbo(data,size); }
 
     template<class V, class I>
     static Tempest::AccelerationStructure
@@ -136,9 +139,20 @@ class Resources final {
 
     static const Tempest::VertexBuffer<VertexFsq>& fsqVbo();
 
+    static void                      memoryUsage(MemoryReport& rep);
+
   private:
     static Resources* inst;
 
+    static size_t     textureSize(const Tempest::Texture2d& t);
+
+    // created via Resources since startup; buffers don't report release
+    struct GpuCounter {
+      std::atomic<size_t> count{0};
+      std::atomic<size_t> bytes{0};
+      void add(size_t sz) { count.fetch_add(1,std::memory_order_relaxed); bytes.fetch_add(sz,std::memory_order_relaxed); }
+      };
+
     struct Archive {
       std::u16string name;
       int64_t        time=0;
@@ -216,4 +230,6 @@ class Resources final {
     std::unordered_map<std::string,std::unique_ptr<PfxEmitterMesh>>       emiMeshCache;
     std::unordered_map<FontK,std::unique_ptr<GthFont>,Hash>               gothicFnt;
     std::unordered_map<std::string,ZenLoad::oCWorldData>                  zenCache;
+
+    GpuCounter                                                            gpuVbo, gpuIbo, gpuSsbo;
   };
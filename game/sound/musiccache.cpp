@@ -0,0 +1,226 @@
+#include "musiccache.h"
+
+#include <Tempest/File>
+#include <Tempest/Log>
+#include <Tempest/TextCodec>
+#include <miniz.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "dmusic/mixer.h"
+#include "dmusic/music.h"
+#include "dmusic/soundfont.h"
+#include "resources.h"
+#include "gothic.h"
+
+using namespace Tempest;
+
+static const char     cacheMagic[4] = {'O','G','M','C'};
+static const uint32_t cacheVersion  = 1;
+
+struct CacheHeader {
+  char     magic[4]   = {};
+  uint32_t version    = 0;
+  uint32_t sampleRate = 0;
+  uint32_t samples    = 0; // int16 values, both channels
+  uint32_t compressed = 0;
+  };
+
+MusicCache::MusicCache() {
+  th = std::thread([this](){ threadFunc(); });
+  }
+
+MusicCache::~MusicCache() {
+  {
+  std::lock_guard<std::mutex> guard(sync);
+  running = false;
+  }
+  workWait.notify_one();
+  th.join();
+  }
+
+MusicCache::Track MusicCache::find(std::string_view file) {
+  std::lock_guard<std::mutex> guard(sync);
+  auto key = std::string(file);
+  auto i   = tracks.find(key);
+  if(i!=tracks.end()) {
+    i->second.lastUse = ++useCounter;
+    return i->second.track;
+    }
+  // null - rendering in progress
+  tracks[key].lastUse = ++useCounter;
+  queue.push_back(std::move(key));
+  workWait.notify_one();
+  return nullptr;
+  }
+
+void MusicCache::threadFunc() {
+  while(true) {
+    std::string file;
+    {
+    std::unique_lock<std::mutex> guard(sync);
+    workWait.wait(guard,[this](){ return !running || queue.size()>0; });
+    if(!running)
+      return;
+    file = std::move(queue.front());
+    queue.erase(queue.begin());
+    }
+
+    Track t;
+    try {
+      auto path = cachePath(file);
+      t = loadFile(path);
+      if(t==nullptr) {
+        t = render(file);
+        if(t==nullptr)
+          return; // shutdown
+        saveFile(path,*t);
+        }
+      }
+    catch(...) {
+      Log::e("unable to pre-render music: \"",file,"\"");
+      continue;
+      }
+
+    std::lock_guard<std::mutex> guard(sync);
+    auto i = tracks.find(file);
+    if(i==tracks.end())
+      continue;
+    i->second.track = std::move(t);
+    evict();
+    }
+  }
+
+void MusicCache::evict() {
+  // playback holds its own reference, so only the cache entry is dropped here
+  size_t loaded = 0;
+  for(auto& i:tracks)
+    if(i.second.track!=nullptr)
+      ++loaded;
+  while(loaded>MaxTracks) {
+    auto lru = tracks.end();
+    for(auto i=tracks.begin(); i!=tracks.end(); ++i)
+      if(i->second.track!=nullptr && (lru==tracks.end() || i->second.lastUse<lru->second.lastUse))
+        lru = i;
+    tracks.erase(lru);
+    --loaded;
+    }
+  }
+
+MusicCache::Track MusicCache::render(const std::string& file) const {
+  Dx8::PatternList p = Resources::loadDxMusic(file);
+
+  Dx8::Music m;
+  m.addPattern(p);
+
+  Dx8::Mixer mix;
+  mix.setMusic(m);
+  // first call only picks up the music
+  int16_t none[2] = {};
+  mix.mix(none,0);
+
+  const uint64_t duration = std::min<uint64_t>(m.duration(),MaxLength*1000);
+  const size_t   length   = size_t(duration*Dx8::SoundFont::SampleRate/1000);
+  if(length<LoopFade*2)
+    throw std::runtime_error("music is too short");
+
+  // render an extra fade-block past the end, to blend it into beginning of the loop
+  auto pcm = std::make_shared<std::vector<int16_t>>((length+LoopFade)*2);
+  for(size_t i=0; i<length+LoopFade; i+=BlockSize) {
+    if(!running.load())
+      return nullptr;
+    size_t cnt = std::min<size_t>(BlockSize,length+LoopFade-i);
+    mix.mix(pcm->data()+i*2,cnt);
+    }
+
+  auto& v = *pcm;
+  for(size_t i=0; i<LoopFade*2; ++i) {
+    float k = float(i/2)/float(LoopFade);
+    float a = float(v[i]);
+    float b = float(v[length*2+i]);
+    v[i] = int16_t(a*k + b*(1.f-k));
+    }
+  v.resize(length*2);
+  return pcm;
+  }
+
+MusicCache::Track MusicCache::loadFile(const std::u16string& path) const {
+  try {
+    RFile       fin(path);
+    CacheHeader h;
+    if(fin.read(&h,sizeof(h))!=sizeof(h))
+      return nullptr;
+    if(std::memcmp(h.magic,cacheMagic,sizeof(cacheMagic))!=0 || h.version!=cacheVersion ||
+       h.sampleRate!=Dx8::SoundFont::SampleRate)
+      return nullptr;
+
+    std::vector<uint8_t> zip(h.compressed);
+    if(fin.read(zip.data(),zip.size())!=zip.size())
+      return nullptr;
+
+    auto     pcm = std::make_shared<std::vector<int16_t>>(h.samples);
+    mz_ulong len = mz_ulong(pcm->size()*sizeof(int16_t));
+    if(mz_uncompress(reinterpret_cast<uint8_t*>(pcm->data()),&len,zip.data(),mz_ulong(zip.size()))!=MZ_OK ||
+       len!=pcm->size()*sizeof(int16_t))
+      return nullptr;
+
+    // undo per-channel delta encoding
+    auto& v = *pcm;
+    for(size_t i=2; i<v.size(); ++i)
+      v[i] = int16_t(uint16_t(v[i])+uint16_t(v[i-2]));
+    return pcm;
+    }
+  catch(...) {
+    return nullptr;
+    }
+  }
+
+void MusicCache::saveFile(const std::u16string& path, const std::vector<int16_t>& pcm) const {
+  // per-channel delta encoding: makes pcm much more friendly to deflate
+  std::vector<int16_t> delta(pcm.size());
+  for(size_t i=0; i<pcm.size(); ++i)
+    delta[i] = i<2 ? pcm[i] : int16_t(uint16_t(pcm[i])-uint16_t(pcm[i-2]));
+
+  const mz_ulong       srcLen = mz_ulong(delta.size()*sizeof(int16_t));
+  mz_ulong             len    = mz_compressBound(srcLen);
+  std::vector<uint8_t> zip(len);
+  if(mz_compress2(zip.data(),&len,reinterpret_cast<const uint8_t*>(delta.data()),srcLen,MZ_DEFAULT_LEVEL)!=MZ_OK)
+    return;
+
+  CacheHeader h;
+  std::memcpy(h.magic,cacheMagic,sizeof(cacheMagic));
+  h.version    = cacheVersion;
+  h.sampleRate = Dx8::SoundFont::SampleRate;
+  h.samples    = uint32_t(pcm.size());
+  h.compressed = uint32_t(len);
+
+  try {
+    WFile fout(path);
+    fout.write(&h,sizeof(h));
+    fout.write(zip.data(),len);
+    }
+  catch(...) {
+    Log::e("unable to write music cache: \"",TextCodec::toUtf8(path),"\"");
+    }
+  }
+
+std::u16string MusicCache::cachePath(std::string_view file) {
+  // keyed on game version and segment content: stale files are never picked up
+  auto& ver  = Gothic::inst().version();
+  char  key[64] = {};
+  std::snprintf(key,sizeof(key),"_g%d_%d_%016llx.bin",int(ver.game),int(ver.patch),
+                static_cast<unsigned long long>(Resources::dxMusicHash(file)));
+
+  std::string name = "musiccache_";
+  for(auto c:file) {
+    if(('a'<=c && c<='z') || ('A'<=c && c<='Z') || ('0'<=c && c<='9') || c=='.' || c=='_')
+      name.push_back(c); else
+      name.push_back('_');
+    }
+  name += key;
+
+  // next to Gothic.ini and other per-installation data
+  auto dir = Gothic::inst().nestedPath({u"system"},Dir::FT_Dir);
+  return dir + TextCodec::toUtf16(name);
+  }
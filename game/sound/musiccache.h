@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class MusicCache final {
+  public:
+    MusicCache();
+    MusicCache(const MusicCache&)=delete;
+    ~MusicCache();
+
+    // interleaved stereo, 44100Hz, seamless loop
+    using Track = std::shared_ptr<const std::vector<int16_t>>;
+
+    // returns pre-rendered theme, if ready; otherwise schedules background rendering and returns null
+    Track find(std::string_view file);
+
+  private:
+    enum {
+      MaxLength  = 10*60, // seconds
+      LoopFade   = 4096,  // samples per channel, used to make loop seamless
+      BlockSize  = 4096,
+      MaxTracks  = 2,     // resident in memory; the rest is reloaded from disk cache
+      };
+
+    struct Entry {
+      Track    track;   // null - loading in progress
+      uint64_t lastUse = 0;
+      };
+
+    void  threadFunc();
+    Track render(const std::string& file) const;
+    Track loadFile(const std::u16string& path) const;
+    void  saveFile(const std::u16string& path, const std::vector<int16_t>& pcm) const;
+    void  evict();
+
+    static std::u16string cachePath(std::string_view file);
+
+    std::mutex                            sync;
+    std::condition_variable               workWait;
+    std::unordered_map<std::string,Entry> tracks;
+    std::vector<std::string>              queue;
+    uint64_t                              useCounter = 0;
+    std::atomic_bool                      running{true};
+    std::thread                           th;
+  };
@@ -5,6 +5,10 @@
 #include <Tempest/Log>
 #include <Tempest/Application>
 
+#include <algorithm>
+#include <condition_variable>
+#include <thread>
+
 #include "bink/video.h"
 #include "utils/fileutil.h"
 #include "gamemusic.h"
@@ -82,6 +86,16 @@ void VideoWidget::Sound::renderSound(int16_t *out, size_t n) {
   }
 
 struct VideoWidget::Context {
+  enum {
+    RingSize = 4,
+    };
+
+  struct Frame {
+    Pixmap                          pm;
+    std::vector<std::vector<float>> audio;
+    size_t                          id = 0;
+    };
+
   Context(const std::u16string& path) : fin(path), input(fin), vid(&input) {
     sndCtx.resize(vid.audioCount());
     for(size_t i=0; i<sndCtx.size(); ++i) {
@@ -91,69 +105,178 @@ struct VideoWidget::Context {
 
     const float volume = Gothic::inst().settingsGetF("SOUND","soundVolume");
     sndDev.setGlobalVolume(volume);
-    frameTime = Application::tickCount();
+
+    decoder = std::thread([this](){ decodeLoop(); });
     }
 
   ~Context() {
+    {
+    std::lock_guard<std::mutex> guard(sync);
+    running = false;
+    }
+    ringWait.notify_all();
+    decoder.join();
     }
 
-  void advance() {
-    auto& f = vid.nextFrame();
-    if(pm.w()!=f.width() || pm.h()!=f.height())
-      pm = Pixmap(f.width(),f.height(),Pixmap::Format::RGBA);
+  // UI thread: picks latest frame, that is due at current time. Returns false, if no new frame is available
+  bool advance() {
+    const uint64_t tick = Application::tickCount();
+    if(frameTime==0)
+      frameTime = tick;
+
+    bool changed = false;
+    while(true) {
+      std::lock_guard<std::mutex> guard(sync);
+      if(count==0)
+        break;
+      auto&    f        = ring[head];
+      uint64_t destTick = frameTime+(1000*vid.fps().den*(f.id-1))/vid.fps().num;
+      if(hasFrame && tick<destTick)
+        break;
+
+      std::swap(pm,f.pm);
+      for(size_t i=0; i<sndCtx.size() && i<f.audio.size(); ++i)
+        sndCtx[i]->pushSamples(f.audio[i]);
+
+      head    = (head+1)%RingSize;
+      count--;
+      changed  = true;
+      hasFrame = true;
+      ringWait.notify_one();
+      }
+    return changed;
+    }
 
-    yuvToRgba(f,pm);
-    for(size_t i=0; i<vid.audioCount(); ++i)
-      sndCtx[i]->pushSamples(f.audio(uint8_t(i)).samples);
+  // decoding thread: decodes ahead into the ring buffer
+  void decodeLoop() {
+    while(true) {
+      size_t slot = 0;
+      {
+      std::unique_lock<std::mutex> guard(sync);
+      ringWait.wait(guard,[this](){ return !running || count<RingSize; });
+      if(!running)
+        return;
+      if(decodedCount>=frameCount) {
+        eof = true;
+        return;
+        }
+      slot = (head+count)%RingSize;
+      }
 
-    uint64_t destTick = frameTime+(1000*vid.fps().den*vid.currentFrame())/vid.fps().num;
-    uint64_t tick     = Application::tickCount();
-    if(tick<destTick) {
-      Application::sleep(uint32_t(destTick-tick));
+      // slot is not visible to UI thread, until count is incremented
+      auto& fr = ring[slot];
+      try {
+        auto& f = vid.nextFrame();
+        if(fr.pm.w()!=f.width() || fr.pm.h()!=f.height())
+          fr.pm = Pixmap(f.width(),f.height(),Pixmap::Format::RGBA);
+        yuvToRgba(f,fr.pm);
+
+        fr.audio.resize(vid.audioCount());
+        for(size_t i=0; i<vid.audioCount(); ++i)
+          fr.audio[i] = f.audio(uint8_t(i)).samples;
+        fr.id = vid.currentFrame();
+        }
+      catch(const Bink::VideoDecodingException& e) { // video exception is recoverable
+        Log::e("video decoding error. frame: ",vid.currentFrame(),", what: \"", e.what(), "\"");
+        std::lock_guard<std::mutex> guard(sync);
+        decodedCount = vid.currentFrame();
+        continue;
+        }
+      catch(...) {
+        Log::e("video decoding error. frame: ",vid.currentFrame());
+        std::lock_guard<std::mutex> guard(sync);
+        failed = true;
+        eof    = true;
+        return;
+        }
+
+      std::lock_guard<std::mutex> guard(sync);
+      decodedCount = vid.currentFrame();
+      count++;
       }
     }
 
+  // BT.601 limited range, 8-bit fixed point; each chroma row is shared by two luma rows
   void yuvToRgba(const Bink::Frame& f,Pixmap& pm) {
-    auto planeY = f.plane(0);
-    auto planeU = f.plane(1);
-    auto planeV = f.plane(2);
-    auto dst    = reinterpret_cast<uint8_t*>(pm.data());
-
-    const uint32_t w = pm.w();
-    for(uint32_t y=0; y<pm.h(); ++y)
-      for(uint32_t x=0; x<w; ++x) {
-        uint8_t* rgb = &dst[(x+y*w)*4];
-        float Y = planeY.at(x,  y  );
-        float U = planeU.at(x/2,y/2);
-        float V = planeV.at(x/2,y/2);
-
-        float r = 1.164f * (Y - 16.f) + 1.596f * (V - 128.f);
-        float g = 1.164f * (Y - 16.f) - 0.813f * (V - 128.f) - 0.391f * (U - 128.f);
-        float b = 1.164f * (Y - 16.f) + 2.018f * (U - 128.f);
-
-        r = std::max(0.f,std::min(r,255.f));
-        g = std::max(0.f,std::min(g,255.f));
-        b = std::max(0.f,std::min(b,255.f));
-
-        rgb[0] = uint8_t(r);
-        rgb[1] = uint8_t(g);
-        rgb[2] = uint8_t(b);
-        rgb[3] = 255;
+    auto& planeY = f.plane(0);
+    auto& planeU = f.plane(1);
+    auto& planeV = f.plane(2);
+    auto  dst    = reinterpret_cast<uint8_t*>(pm.data());
+
+    const uint32_t w  = pm.w();
+    const uint32_t h  = pm.h();
+    const uint32_t cw = (w+1)/2;
+
+    chromaR.resize(cw);
+    chromaG.resize(cw);
+    chromaB.resize(cw);
+
+    for(uint32_t y=0; y<h; y+=2) {
+      const uint8_t* u = planeU.row(y/2);
+      const uint8_t* v = planeV.row(y/2);
+      for(uint32_t x=0; x<cw; ++x) {
+        const int32_t d = int32_t(u[x]) - 128;
+        const int32_t e = int32_t(v[x]) - 128;
+        chromaR[x] =  409*e + 128;
+        chromaG[x] = -100*d - 208*e + 128;
+        chromaB[x] =  516*d + 128;
         }
+
+      yuvRowToRgba(planeY.row(y), dst+size_t(y)*w*4, w);
+      if(y+1<h)
+        yuvRowToRgba(planeY.row(y+1), dst+size_t(y+1)*w*4, w);
+      }
     }
 
-  bool isEof() const {
-    return vid.currentFrame()>=vid.frameCount();
+  void yuvRowToRgba(const uint8_t* src, uint8_t* rgb, uint32_t w) const {
+    const int32_t* cr = chromaR.data();
+    const int32_t* cg = chromaG.data();
+    const int32_t* cb = chromaB.data();
+    // branch-free loop, to be vectorized by compiler
+    for(uint32_t x=0; x<w; ++x) {
+      const int32_t c = 298*(int32_t(src[x]) - 16);
+      const int32_t r = (c + cr[x/2]) >> 8;
+      const int32_t g = (c + cg[x/2]) >> 8;
+      const int32_t b = (c + cb[x/2]) >> 8;
+      rgb[x*4+0] = uint8_t(std::clamp(r,0,255));
+      rgb[x*4+1] = uint8_t(std::clamp(g,0,255));
+      rgb[x*4+2] = uint8_t(std::clamp(b,0,255));
+      rgb[x*4+3] = 255;
+      }
+    }
+
+  bool isEof() {
+    std::lock_guard<std::mutex> guard(sync);
+    return eof && count==0;
+    }
+
+  bool isFailed() {
+    std::lock_guard<std::mutex> guard(sync);
+    return failed;
     }
 
   Tempest::RFile       fin;
   Input                input;
   Bink::Video          vid;
+  const size_t         frameCount = vid.frameCount();
   Pixmap               pm;
+  std::vector<int32_t> chromaR, chromaG, chromaB;
   uint64_t             frameTime = 0;
+  bool                 hasFrame  = false;
 
   Tempest::SoundDevice      sndDev;
   std::vector<std::unique_ptr<SoundContext>> sndCtx;
+
+  std::mutex               sync;
+  std::condition_variable  ringWait;
+  Frame                    ring[RingSize];
+  size_t                   head         = 0;
+  size_t                   count        = 0;
+  size_t                   decodedCount = 0;
+  bool                     running      = true;
+  bool                     eof          = false;
+  bool                     failed       = false;
+  std::thread              decoder;
   };
 
 VideoWidget::VideoWidget() {
@@ -239,19 +362,15 @@ void VideoWidget::stopVideo() {
 void VideoWidget::paint(Tempest::Device& device, uint8_t fId) {
   if(ctx==nullptr)
     return;
-  try {
-    ctx->advance();
+  if(ctx->isFailed()) {
+    ctx.reset();
+    return;
+    }
+  if(ctx->advance()) {
     tex[fId] = device.texture(ctx->pm,false);
     frame    = &tex[fId];
-    update();
-    }
-  catch(const Bink::VideoDecodingException& e) { // video exception is recoverable
-    Log::e("video decoding error. frame: ",ctx->vid.currentFrame(),", what: \"", e.what(), "\"");
-    }
-  catch(...) {
-    Log::e("video decoding error. frame: ",ctx->vid.currentFrame());
-    ctx.reset();
     }
+  update();
   }
 
 void VideoWidget::paintEvent(PaintEvent& e) {
@@ -0,0 +1,118 @@
+#include "frameprofiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+
+std::atomic_bool                                    FrameProfiler::enabled{false};
+std::mutex                                          FrameProfiler::sync;
+std::vector<std::unique_ptr<FrameProfiler::Buffer>> FrameProfiler::buffers;
+
+static std::atomic<uint64_t> captureStart{0};
+
+void FrameProfiler::setEnabled(bool e) {
+  if(e) {
+    if(!isEnabled())
+      captureStart.store(now());
+    enabled.store(true);
+    return;
+    }
+
+  enabled.store(false);
+  // pairs with push: writer either sees capture disabled, or is waited for here
+  std::lock_guard<std::mutex> guard(sync);
+  for(auto& b:buffers) {
+    while(b->busy.load())
+      std::this_thread::yield();
+    b->stop = b->head.load(std::memory_order_acquire);
+    }
+  }
+
+uint64_t FrameProfiler::now() {
+  auto t = std::chrono::steady_clock::now().time_since_epoch();
+  return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(t).count());
+  }
+
+FrameProfiler::Buffer& FrameProfiler::threadBuffer() {
+  thread_local Buffer* buf = nullptr;
+  if(buf!=nullptr)
+    return *buf;
+
+  std::lock_guard<std::mutex> guard(sync);
+  auto b = std::make_unique<Buffer>();
+  b->tid = uint32_t(buffers.size());
+  b->ring.resize(Capacity);
+  buf = b.get();
+  buffers.emplace_back(std::move(b));
+  return *buf;
+  }
+
+void FrameProfiler::push(const char* name, uint64_t begin, uint64_t end) {
+  auto& b = threadBuffer();
+  b.busy.store(true);
+  if(enabled.load()) {
+    uint64_t h = b.head.load(std::memory_order_relaxed);
+    auto&    e = b.ring[h%Capacity];
+    e.name  = name;
+    e.begin = begin;
+    e.end   = end;
+    b.head.store(h+1,std::memory_order_release);
+    }
+  b.busy.store(false,std::memory_order_release);
+  }
+
+bool FrameProfiler::dump(std::string_view file) {
+  std::string path(file);
+  FILE* f = std::fopen(path.c_str(),"wb");
+  if(f==nullptr)
+    return false;
+
+  const uint64_t t0 = captureStart.load();
+  setEnabled(false);
+
+  std::lock_guard<std::mutex> guard(sync);
+  std::fputs("{\"traceEvents\":[\n",f);
+  bool first = true;
+  for(auto& b:buffers) {
+    std::fprintf(f,"%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+                 first ? "" : ",\n", unsigned(b->tid), unsigned(b->tid));
+    first = false;
+
+    const uint64_t h = b->stop;
+    const uint64_t s = h>Capacity ? h-Capacity : 0;
+    for(uint64_t i=s; i<h; ++i) {
+      auto& e = b->ring[i%Capacity];
+      if(e.begin<t0 || e.end<e.begin)
+        continue;
+      std::fprintf(f,",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                   e.name, unsigned(b->tid), double(e.begin-t0)/1000.0, double(e.end-e.begin)/1000.0);
+      }
+    }
+  std::fputs("\n]}\n",f);
+  return std::fclose(f)==0;
+  }
+
+void FrameProfiler::collect(std::vector<Stat>& stat) {
+  std::lock_guard<std::mutex> guard(sync);
+  for(auto& b:buffers) {
+    const uint64_t h = b->head.load(std::memory_order_acquire);
+    const uint64_t s = std::max(b->tail, h>Capacity ? h-Capacity : 0);
+    for(uint64_t i=s; i<h; ++i) {
+      auto& e  = b->ring[i%Capacity];
+      auto  it = std::find_if(stat.begin(),stat.end(),[&e](const Stat& s){
+        return std::strcmp(s.name,e.name)==0;
+        });
+      if(it==stat.end()) {
+        stat.emplace_back();
+        it = stat.end()-1;
+        it->name = e.name;
+        }
+      it->calls++;
+      it->total += e.end-e.begin;
+      }
+    b->tail = h;
+    }
+  }
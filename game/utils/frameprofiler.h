@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+class FrameProfiler final {
+  public:
+    // scoped cpu-zone; name must be a string literal
+    class Zone final {
+      public:
+        explicit Zone(const char* name) {
+          if(!isEnabled())
+            return;
+          this->name  = name;
+          this->start = now();
+          }
+        Zone(const Zone&)=delete;
+        ~Zone() {
+          if(name!=nullptr && isEnabled())
+            push(name,start,now());
+          }
+
+      private:
+        const char* name  = nullptr;
+        uint64_t    start = 0;
+      };
+
+    struct Stat {
+      const char* name  = nullptr;
+      uint64_t    calls = 0;
+      uint64_t    total = 0; // ns
+      };
+
+    // disabling waits for in-flight pushes; events recorded afterwards are not dumped
+    static void setEnabled(bool e);
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    // chrome://tracing or ui.perfetto.dev json; stops capture
+    static bool dump(std::string_view file);
+    // adds events, recorded since previous call, to per-zone totals; must not run concurrently with zones
+    static void collect(std::vector<Stat>& stat);
+
+  private:
+    enum {
+      Capacity = 1<<16, // events per thread
+      };
+
+    struct Event {
+      const char* name  = nullptr;
+      uint64_t    begin = 0;
+      uint64_t    end   = 0;
+      };
+
+    // single writer (owning thread), events are overwritten in ring order
+    struct Buffer {
+      uint32_t              tid = 0;
+      std::vector<Event>    ring;
+      std::atomic<uint64_t> head{0};
+      std::atomic_bool      busy{false};
+      uint64_t              stop = 0; // head, when capture was disabled
+      uint64_t              tail = 0; // used by collect
+      };
+
+    static uint64_t now();
+    static void     push(const char* name, uint64_t begin, uint64_t end);
+    static Buffer&  threadBuffer();
+
+    static std::atomic_bool                     enabled;
+    static std::mutex                           sync;
+    static std::vector<std::unique_ptr<Buffer>> buffers;
+  };
@@ -1,6 +1,7 @@
 #include "gthfont.h"
 
 #include <Tempest/Size>
+#include <cstring>
 #include "resources.h"
 
 using namespace Tempest;
@@ -21,22 +22,70 @@ void GthFont::drawText(Painter &p, int bx, int by, int bw, int bh,
 
   auto b = p.brush();
   p.setBrush(Brush(*tex,color));
-  processText(&p,bx,by,bw,bh,txt,align,firstLine);
+
+  std::lock_guard<std::mutex> guard(sync);
+  const Layout& l  = layout(txt,bw);
+  const int     h  = pixelSize();
+  int           y  = by-h;
+  int           th = 0;
+  for(size_t i=size_t(std::max(firstLine,0)); i<l.lines.size(); ++i) {
+    auto& ln = l.lines[i];
+    if(th+ln.h>bh && bh>0)
+      break;
+    th += ln.h;
+
+    int x = bx;
+    if(align!=NoAlign && align!=AlignLeft) {
+      if(align & AlignHCenter)
+        x = bx + (bw-ln.w)/2;
+      if(align & AlignRight)
+        x = bx + (bw-ln.w);
+      }
+
+    for(size_t r=ln.begin; r<ln.end; ++r) {
+      auto& g = l.glyphs[r];
+      p.drawRect(x+g.x,y, g.w,h, g.u0,g.v0, g.u1,g.v1);
+      }
+    y += ln.h;
+    }
   p.setBrush(b);
   }
 
-Size GthFont::processText(Painter* p, int bx, int by, int bw, int bh,
-                          std::string_view txtView, AlignFlag align, int firstLine) const {
-  const uint8_t* txt = reinterpret_cast<const uint8_t*>(txtView.data());
+const GthFont::Layout& GthFont::layout(std::string_view txt, int bw) const {
+  // text is processed up to '\0', same as before caching
+  txt = std::string_view(txt.data(),std::strlen(txt.data()));
 
-  int   h  = pixelSize();
-  int   x  = bx, y=by-h;
-  float tw = float(tex->w());
-  float th = float(tex->h());
+  auto it = layouts.find(txt);
+  if(it!=layouts.end()) {
+    for(auto& l:it->second)
+      if(l.bw==bw) {
+        stat.hits++;
+        return l;
+        }
+    } else {
+    if(layoutCount>=MaxLayouts) {
+      layouts.clear();
+      layoutCount = 0;
+      }
+    it = layouts.emplace(std::string(txt),std::vector<Layout>()).first;
+    }
 
+  stat.misses++;
+  layoutCount++;
+  auto& l = it->second.emplace_back();
+  mkLayout(l,txt,bw);
+  return l;
+  }
+
+void GthFont::mkLayout(Layout& out, std::string_view txtView, int bw) const {
+  const uint8_t* txt = reinterpret_cast<const uint8_t*>(txtView.data());
+
+  auto& info = fnt.getFontInfo();
+  float tw   = float(tex->w());
+  float th   = float(tex->h());
   int   lwidth = 0;
 
-  Size ret = {0,0};
+  out.bw = bw;
   while(*txt) {
     auto t    = getLine(txt,bw,lwidth);
     auto sz   = textSize(txt,t);
@@ -47,46 +96,40 @@ Size GthFont::processText(Painter* p, int bx, int by, int bw, int bh,
     while(*next==' ')
       ++next; // lead spaces of next line
 
-    if(firstLine>0) {
-      txt = next;
-      --firstLine;
-      continue;
-      }
-    if(ret.h+sz.h>bh && bh>0) {
-      break;
-      }
-
-    ret.w  = std::max(ret.w,sz.w);
-    ret.h += sz.h;
-
-    if(align!=NoAlign && align!=AlignLeft) {
-      int x1 = x;
-      if(align & AlignHCenter)
-        x1 = x + (bw-sz.w)/2;
-      if(align & AlignRight)
-        x1 = x + (bw-sz.w);
-      x = x1;
-      }
+    Line ln;
+    ln.begin = out.glyphs.size();
+    ln.w     = sz.w;
+    ln.h     = sz.h;
 
+    int x = 0;
     for(auto i=txt; i!=t; ++i) {
       uint8_t id  = *i;
-      auto&   uv1 = fnt.getFontInfo().fontUV1[id];
-      auto&   uv2 = fnt.getFontInfo().fontUV2[id];
-      int     w   = fnt.getFontInfo().glyphWidth[id];
-
-      if(p!=nullptr) {
-        p->drawRect(x,y, w,h,
-                    tw*uv1.x,th*uv1.y, tw*uv2.x,th*uv2.y);
-        }
-      x += w;
+      auto&   uv1 = info.fontUV1[id];
+      auto&   uv2 = info.fontUV2[id];
+      Glyph   g;
+      g.x  = x;
+      g.w  = info.glyphWidth[id];
+      g.u0 = tw*uv1.x;
+      g.v0 = th*uv1.y;
+      g.u1 = tw*uv2.x;
+      g.v1 = th*uv2.y;
+      out.glyphs.push_back(g);
+      x += g.w;
       }
+    ln.end = out.glyphs.size();
+    out.lines.push_back(ln);
 
+    out.size.w  = std::max(out.size.w,sz.w);
+    out.size.h += sz.h;
     txt = next;
-    x   = bx;
-    y  += sz.h;
     }
+  }
 
-  return ret;
+GthFont::Stats GthFont::stats() const {
+  std::lock_guard<std::mutex> guard(sync);
+  Stats st = stat;
+  st.entries = layoutCount;
+  return st;
   }
 
 void GthFont::drawText(Tempest::Painter &p, int bx, int by, std::string_view txtChar) const {
@@ -160,14 +203,15 @@ Size GthFont::textSize(const uint8_t* b, const uint8_t* e) const {
 Size GthFont::textSize(int bw, std::string_view txt) const {
   if(tex==nullptr || txt.empty())
     return Size();
-  return processText(nullptr,0,0,bw,0,txt,NoAlign,0);
+  std::lock_guard<std::mutex> guard(sync);
+  return layout(txt,bw).size;
   }
 
 int32_t GthFont::lineCount(int bw, std::string_view txt) const {
   if(tex==nullptr || txt.empty())
     return 0;
-  auto ret = processText(nullptr,0,0,bw,0,txt,NoAlign,0);
-  return ret.h/pixelSize();
+  std::lock_guard<std::mutex> guard(sync);
+  return layout(txt,bw).size.h/pixelSize();
   }
 
 const uint8_t* GthFont::getLine(const uint8_t *txt, int bw, int& width) const {
@@ -3,6 +3,11 @@
 #include <zenload/zCFont.h>
 #include <Tempest/Painter>
 
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 class GthFont final {
   public:
     GthFont(const char* name, std::string_view tex, const Tempest::Color& cl, const VDFS::FileIndex& fileIndex);
@@ -19,15 +24,56 @@ class GthFont final {
     auto textSize(int w, std::string_view txt) const -> Tempest::Size;
     auto lineCount(int w, std::string_view txt) const -> int32_t;
 
+    struct Stats {
+      size_t entries = 0;
+      size_t hits    = 0;
+      size_t misses  = 0;
+      };
+    Stats stats() const;
+
   private:
+    enum {
+      MaxLayouts = 1024,
+      };
+
+    struct Glyph {
+      int   x = 0, w = 0;          // relative to line start
+      float u0 = 0, v0 = 0, u1 = 0, v1 = 0;
+      };
+
+    struct Line {
+      size_t begin = 0, end = 0;   // range in Layout::glyphs
+      int    w = 0, h = 0;
+      };
+
+    // word-wrapped text for a given box width
+    struct Layout {
+      int                bw = 0;
+      std::vector<Line>  lines;
+      std::vector<Glyph> glyphs;
+      Tempest::Size      size;
+      };
+
+    struct TextHash {
+      using is_transparent = void;
+      size_t operator()(std::string_view s) const { return std::hash<std::string_view>()(s); }
+      };
+
     ZenLoad::zCFont           fnt;
     const Tempest::Texture2d* tex=nullptr;
     Tempest::Color            color;
 
+    mutable std::mutex                                                                sync;
+    mutable std::unordered_map<std::string,std::vector<Layout>,TextHash,std::equal_to<>> layouts;
+    mutable size_t                                                                    layoutCount = 0;
+    mutable Stats                                                                     stat;
+
+    const Layout&  layout(std::string_view txt, int bw) const;
+    void           mkLayout(Layout& out, std::string_view txt, int bw) const;
+
     const uint8_t* getLine(const uint8_t* txt, int bw, int &width) const;
     const uint8_t* getWord(const uint8_t* txt, int &width, int &space) const;
 
     static bool    isSpace(uint8_t ch);
-    Tempest::Size  processText(Tempest::Painter* p, int x, int y, int w, int h, std::string_view txt, Tempest::AlignFlag align, int firstLine) const;
   };
 
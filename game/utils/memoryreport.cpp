@@ -0,0 +1,52 @@
+#include "memoryreport.h"
+
+#include <cstdio>
+
+void MemoryReport::add(std::string_view name, size_t count, size_t bytes) {
+  implAdd(name,count,bytes,false,true);
+  }
+
+void MemoryReport::addGpu(std::string_view name, size_t count, size_t bytes) {
+  implAdd(name,count,bytes,true,true);
+  }
+
+void MemoryReport::addGpuCreated(std::string_view name, size_t count, size_t bytes) {
+  implAdd(name,count,bytes,true,false);
+  }
+
+void MemoryReport::implAdd(std::string_view name, size_t count, size_t bytes, bool gpu, bool sum) {
+  for(auto& i:data)
+    if(i.name==name && i.gpu==gpu && i.sum==sum) {
+      i.count += count;
+      i.bytes += bytes;
+      return;
+      }
+  Entry e;
+  e.name  = name;
+  e.count = count;
+  e.bytes = bytes;
+  e.gpu   = gpu;
+  e.sum   = sum;
+  data.push_back(std::move(e));
+  }
+
+size_t MemoryReport::total(bool gpu) const {
+  size_t ret = 0;
+  for(auto& i:data)
+    if(i.gpu==gpu && i.sum)
+      ret += i.bytes;
+  return ret;
+  }
+
+void MemoryReport::print(const std::function<void(std::string_view)>& out) const {
+  char buf[256] = {};
+  for(auto& i:data) {
+    std::snprintf(buf,sizeof(buf),"%s%-20s %8.2f MB (%u)%s", i.gpu ? "gpu: " : "",
+                  i.name.c_str(), double(i.bytes)/(1024.0*1024.0), unsigned(i.count),
+                  i.sum ? "" : " created since startup, not in total");
+    out(buf);
+    }
+  std::snprintf(buf,sizeof(buf),"total: cpu = %.2f MB, gpu = %.2f MB",
+                double(total(false))/(1024.0*1024.0), double(total(true))/(1024.0*1024.0));
+  out(buf);
+  }
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// per-subsystem memory budget; cpu sizes are estimated from container capacities
+class MemoryReport final {
+  public:
+    struct Entry {
+      std::string name;
+      size_t      count = 0;
+      size_t      bytes = 0;
+      bool        gpu   = false;
+      bool        sum   = true; // false for cumulative counters, that are not included into total
+      };
+
+    void   add   (std::string_view name, size_t count, size_t bytes);
+    void   addGpu(std::string_view name, size_t count, size_t bytes);
+    // allocated since startup, including already released memory
+    void   addGpuCreated(std::string_view name, size_t count, size_t bytes);
+    size_t total(bool gpu) const;
+
+    const std::vector<Entry>& entries() const { return data; }
+    void   print(const std::function<void(std::string_view)>& out) const;
+
+  private:
+    void   implAdd(std::string_view name, size_t count, size_t bytes, bool gpu, bool sum);
+
+    std::vector<Entry> data;
+  };
@@ -1,4 +1,5 @@
 #include "workers.h"
+#include "frameprofiler.h"
 
 #include <Tempest/Log>
 
@@ -85,6 +86,7 @@ void Workers::threadFunc(size_t id) {
     // Log::d("worker: id = ",id," [",b, ", ",e,"]");
 
     if(b!=e) {
+      FrameProfiler::Zone zone("Workers::task");
       void* d = workSet + b*workEltSize;
       workFunc(d,e-b);
       }
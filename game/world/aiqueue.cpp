@@ -1,5 +1,6 @@
 #include "aiqueue.h"
 
+#include <algorithm>
 #include <limits>
 #include "game/serialize.h"
 
@@ -7,8 +8,9 @@ AiQueue::AiQueue() {
   }
 
 void AiQueue::save(Serialize& fout) const {
-  fout.write(uint32_t(aiActions.size()));
-  for(auto& i:aiActions){
+  fout.write(uint32_t(count));
+  for(size_t id=0; id<count; ++id) {
+    auto& i = at(id);
     fout.write(uint32_t(i.act));
     fout.write(i.target,i.victum);
     fout.write(i.point,i.func,i.i0,i.i1,i.s0);
@@ -20,8 +22,11 @@ void AiQueue::save(Serialize& fout) const {
 void AiQueue::load(Serialize& fin) {
   uint32_t size = 0;
   fin.read(size);
-  aiActions.resize(size);
-  for(auto& i:aiActions){
+  clear();
+  reserve(size);
+  count = size;
+  for(size_t id=0; id<count; ++id) {
+    auto& i = at(id);
     fin.read(reinterpret_cast<uint32_t&>(i.act));
     fin.read(i.target,i.victum);
     fin.read(i.point,i.func,i.i0,i.i1,i.s0);
@@ -31,17 +36,38 @@ void AiQueue::load(Serialize& fin) {
   }
 
 void AiQueue::clear() {
-  aiActions.clear();
+  // keep storage, but release strings
+  for(size_t i=0; i<count; ++i)
+    at(i) = AiAction();
+  head  = 0;
+  count = 0;
+  }
+
+void AiQueue::reserve(size_t sz) {
+  if(sz<=aiActions.size())
+    return;
+  size_t cap = std::max<size_t>(aiActions.size(),MinCapacity);
+  while(cap<sz)
+    cap *= 2;
+
+  std::vector<AiAction> next(cap);
+  for(size_t i=0; i<count; ++i)
+    next[i] = std::move(at(i));
+  aiActions = std::move(next);
+  head      = 0;
   }
 
 void AiQueue::pushBack(AiAction&& a) {
-  if(aiActions.size()>0) {
-    if(aiActions.back().act==AI_LookAt && a.act==AI_LookAt) {
-      aiActions.back() = a;
+  if(count>0) {
+    auto& back = at(count-1);
+    if(back.act==AI_LookAt && a.act==AI_LookAt) {
+      back = std::move(a);
       return;
       }
     }
-  aiActions.push_back(a);
+  reserve(count+1);
+  at(count) = std::move(a);
+  ++count;
   }
 
 void AiQueue::pushFront(AiQueue::AiAction&& a) {
@@ -49,27 +75,35 @@ void AiQueue::pushFront(AiQueue::AiAction&& a) {
     assert(a.i2==0);
     assert(a.s1.empty());
     }
-  aiActions.push_front(a);
+  reserve(count+1);
+  head = (head+aiActions.size()-1)&(aiActions.size()-1);
+  aiActions[head] = std::move(a);
+  ++count;
   }
 
 AiQueue::AiAction AiQueue::pop() {
-  auto act = std::move(aiActions.front());
-  aiActions.pop_front();
+  auto act = std::move(aiActions[head]);
+  head = (head+1)&(aiActions.size()-1);
+  --count;
   return act;
   }
 
 int AiQueue::aiOutputOrderId() const {
   int v = std::numeric_limits<int>::max();
-  for(auto& i:aiActions)
+  for(size_t id=0; id<count; ++id) {
+    auto& i = at(id);
     if(i.i0<v && (i.act==AI_Output || i.act==AI_OutputSvm || i.act==AI_OutputSvmOverlay))
       v = i.i0;
+    }
   return v;
   }
 
 void AiQueue::onWldItemRemoved(const Item& itm) {
-  for(auto& i:aiActions)
+  for(size_t id=0; id<count; ++id) {
+    auto& i = at(id);
     if(i.item==&itm)
       i.item = nullptr;
+    }
   }
 
 AiQueue::AiAction AiQueue::aiLookAt(Npc* other) {
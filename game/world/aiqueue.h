@@ -2,7 +2,7 @@
 
 #include <daedalus/ZString.h>
 #include <cstdint>
-#include <deque>
+#include <vector>
 
 #include "game/gamescript.h"
 #include "game/constants.h"
@@ -34,7 +34,7 @@ class AiQueue {
     void     save(Serialize& fout) const;
     void     load(Serialize& fin);
 
-    size_t   size() const { return aiActions.size(); }
+    size_t   size() const { return count; }
     void     clear();
     void     pushBack (AiAction&& a);
     void     pushFront(AiAction&& a);
@@ -92,6 +92,17 @@ class AiQueue {
     static AiAction aiPrintScreen(int time, const Daedalus::ZString& font, int x,int y, const Daedalus::ZString& msg);
 
   private:
-    std::deque<AiAction> aiActions;
+    enum {
+      MinCapacity = 8,
+      };
+
+    AiAction&       at(size_t i)       { return aiActions[(head+i)&(aiActions.size()-1)]; }
+    const AiAction& at(size_t i) const { return aiActions[(head+i)&(aiActions.size()-1)]; }
+    void            reserve(size_t sz);
+
+    // ring buffer, capacity is power of two; grows only past high-water mark
+    std::vector<AiAction> aiActions;
+    size_t                head  = 0;
+    size_t                count = 0;
   };
 
@@ -72,6 +72,7 @@ Interactive::Interactive(Vob* parent, World &world, ZenLoad::zCVobData& vob, Fla
     stateNum   = stepsCount;
     }
 
+  resolveScriptFn();
   world.addInteractive(this);
   }
 
@@ -85,6 +86,7 @@ void Interactive::load(Serialize &fin) {
   fin.read(stateNum,triggerTarget,useWithItem,conditionFunc,onStateFunc);
   fin.read(locked,keyInstance,pickLockStr);
   fin.read(state,reverseState,loopState,isLockCracked);
+  resolveScriptFn();
 
   uint32_t sz=0;
   fin.read(sz);
@@ -176,7 +178,14 @@ void Interactive::setVisual(ZenLoad::zCVobData& vob) {
   setAnim(Interactive::Active); // setup default anim
   }
 
-void Interactive::updateAnimation(uint64_t dt) {
+void Interactive::updateAnimation(uint64_t dt, bool skip) {
+  dt += animSkippedDt;
+  if(skip) {
+    animSkippedDt = dt;
+    visual.skipAnimation(nullptr,world);
+    return;
+    }
+  animSkippedDt = 0;
   if(visual.updateAnimation(nullptr,world,dt))
     animChanged = true;
   }
@@ -388,11 +397,26 @@ void Interactive::invokeStateFunc(Npc& npc) {
     return;
   if(loopState)
     return;
-  char func[256]={};
-  std::snprintf(func,sizeof(func),"%s_S%d",onStateFunc.c_str(),state);
-
+  if(size_t(state)>=stateFn.size())
+    return;
   auto& sc = npc.world().script();
-  sc.useInteractive(npc.handle(),func);
+  sc.useInteractive(npc.handle(),stateFn[size_t(state)]);
+  }
+
+void Interactive::resolveScriptFn() {
+  // resolve once, instead of symbol lookup on every use
+  auto& sc = world.script();
+  conditionFn = conditionFunc.empty() ? ScriptFn() : ScriptFn(sc.getSymbolIndex(conditionFunc));
+
+  stateFn.clear();
+  if(onStateFunc.empty())
+    return;
+  stateFn.resize(size_t(std::max(stateNum,0)+1));
+  for(size_t i=0; i<stateFn.size(); ++i) {
+    char func[256]={};
+    std::snprintf(func,sizeof(func),"%s_S%d",onStateFunc.c_str(),int(i));
+    stateFn[i] = sc.getSymbolIndex(func);
+    }
   }
 
 void Interactive::emitTriggerEvent() const {
@@ -543,7 +567,7 @@ bool Interactive::checkUseConditions(Npc& npc) {
       }
 
     if(!conditionFunc.empty()) {
-      const int check = sc.invokeCond(npc,conditionFunc);
+      const int check = sc.invokeCond(npc,conditionFn);
       if(check==0)
         return false;
       }
@@ -7,6 +7,7 @@
 #include "graphics/objvisual.h"
 #include "graphics/meshobjects.h"
 #include "game/inventory.h"
+#include "game/gamescript.h"
 #include "vob.h"
 
 class Npc;
@@ -31,7 +32,7 @@ class Interactive : public Vob {
     void                postValidate();
 
     void                resetPositionToTA(int32_t state);
-    void                updateAnimation(uint64_t dt);
+    void                updateAnimation(uint64_t dt, bool skip);
     void                tick(uint64_t dt);
 
     std::string_view    tag() const;
@@ -101,6 +102,7 @@ class Interactive : public Vob {
 
     void                setVisual(ZenLoad::zCVobData& vob);
     void                invokeStateFunc(Npc &npc);
+    void                resolveScriptFn();
     void                implTick(Pos &p, uint64_t dt);
     void                implQuitInteract(Pos &p);
     void                setPos(Npc& npc, const Tempest::Vec3& pos);
@@ -141,6 +143,8 @@ class Interactive : public Vob {
     std::string                  useWithItem;
     std::string                  conditionFunc;
     std::string                  onStateFunc;
+    ScriptFn                     conditionFn;
+    std::vector<ScriptFn>        stateFn; // <onStateFunc>_S<state>, index by state
     bool                         rewind = false;
     //  oCMobContainer
     bool                         locked=false;
@@ -157,6 +161,7 @@ class Interactive : public Vob {
 
     uint64_t                     waitAnim      = 0;
     bool                         animChanged   = false;
+    uint64_t                     animSkippedDt = 0;
 
     std::vector<Pos>             attPos;
     PhysicMesh                   physic;
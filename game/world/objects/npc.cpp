@@ -15,6 +15,7 @@
 #include "world/world.h"
 #include "utils/versioninfo.h"
 #include "utils/fileext.h"
+#include "utils/frameprofiler.h"
 #include "camera.h"
 #include "gothic.h"
 #include "resources.h"
@@ -809,9 +810,7 @@ void Npc::dropTorch(bool burnout) {
   size_t leftHand = sk->findNode("ZS_LEFTHAND");
   if(torchId!=size_t(-1) && leftHand!=size_t(-1)) {
 
-    auto mat = visual.transform();
-    if(leftHand<visual.pose().boneCount())
-      mat = visual.pose().bone(leftHand);
+    auto mat = visual.boneMatrix(leftHand);
 
     owner.addItemDyn(torchId,mat,hnpc.instanceSymbol);
     }
@@ -2899,9 +2898,7 @@ void Npc::dropItem(size_t id, size_t count) {
   if(!setAnim(Anim::ItmDrop))
     return;
 
-  auto mat = visual.transform();
-  if(leftHand<visual.pose().boneCount())
-    mat = visual.pose().bone(leftHand);
+  auto mat = visual.boneMatrix(leftHand);
 
   auto it = owner.addItemDyn(id,mat,hnpc.instanceSymbol);
   it->setCount(count);
@@ -3520,6 +3517,8 @@ bool Npc::perceptionProcess(Npc &pl) {
   if(disable)
     return false;
 
+  FrameProfiler::Zone zone("Npc::perceptionProcess");
+
   if(isPlayer())
     return true;
 
@@ -4021,7 +4020,29 @@ void Npc::updateTransform() {
   updateAnimation(0);
   }
 
+void Npc::updateAnimation(uint64_t dt, bool skip, bool visible) {
+  // visible npc's keep moving smoothly, even on reduced update rate
+  if(skip && !(visible && durtyTranform!=0)) {
+    // transform and overlays stay current, pose is sampled later or on first bone query
+    animSkippedDt += dt;
+    applyTransform();
+    visual.skipAnimation(this,owner);
+    return;
+    }
+  updateAnimation(dt);
+  }
+
 void Npc::updateAnimation(uint64_t dt) {
+  dt += animSkippedDt;
+  animSkippedDt = 0;
+
+  applyTransform();
+  bool syncAtt = visual.updateAnimation(this,owner,dt);
+  if(syncAtt)
+    visual.syncAttaches();
+  }
+
+void Npc::applyTransform() {
   if(durtyTranform) {
     const auto ground = groundNormal();
     if(lastGroundNormal!=ground) {
@@ -4049,8 +4070,4 @@ void Npc::updateAnimation(uint64_t dt) {
     visual.setObjMatrix(pos,false);
     durtyTranform = 0;
     }
-
-  bool syncAtt = visual.updateAnimation(this,owner,dt);
-  if(syncAtt)
-    visual.syncAttaches();
   }
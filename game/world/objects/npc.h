@@ -128,6 +128,7 @@ class Npc final {
     float      qDistTo(const Item& p) const;
 
     void       updateAnimation(uint64_t dt);
+    void       updateAnimation(uint64_t dt, bool skip, bool visible);
     void       updateTransform();
 
     std::string_view displayName() const;
@@ -495,6 +496,7 @@ class Npc final {
     bool               isAlignedToGround() const;
     Tempest::Vec3      groundNormal() const;
     Tempest::Matrix4x4 mkPositionMatrix() const;
+    void               applyTransform();
 
     World&                         owner;
     // main props
@@ -515,6 +517,7 @@ class Npc final {
     // visual props (cache)
     uint8_t                        durtyTranform=0;
     Tempest::Vec3                  lastGroundNormal;
+    uint64_t                       animSkippedDt=0;
 
     DynamicWorld::NpcItem          physic;
 
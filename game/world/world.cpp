@@ -16,6 +16,8 @@
 #include "world/objects/interactive.h"
 #include "game/globaleffects.h"
 #include "game/serialize.h"
+#include "utils/frameprofiler.h"
+#include "utils/memoryreport.h"
 #include "gothic.h"
 #include "focus.h"
 #include "resources.h"
@@ -64,6 +66,7 @@ const char* materialTag(ZenLoad::MaterialGroup src) {
 World::World(GameSession& game, std::string file, bool startup, std::function<void(int)> loadProgress)
   :wname(std::move(file)),game(game),wsound(game,*this),wobj(*this) {
   using namespace Daedalus::GameState;
+  FrameProfiler::Zone zone("World::load");
 
   ZenLoad::ZenParser parser(wname,Resources::vdfsIndex());
   loadProgress(1);
@@ -267,6 +270,7 @@ MeshObjects::Mesh World::addDecalView(const ZenLoad::zCVobData& vob) {
   }
 
 void World::updateAnimation(uint64_t dt) {
+  FrameProfiler::Zone zone("World::updateAnimation");
   wobj.updateAnimation(dt);
   }
 
@@ -274,6 +278,13 @@ void World::resetPositionToTA() {
   wobj.resetPositionToTA();
   }
 
+void World::memoryUsage(MemoryReport& rep) const {
+  if(wview!=nullptr)
+    wview->memoryUsage(rep);
+  if(wdynamic!=nullptr)
+    wdynamic->memoryUsage(rep);
+  }
+
 std::unique_ptr<Npc> World::takeHero() {
   return wobj.takeNpc(npcPlayer);
   }
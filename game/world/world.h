@@ -31,6 +31,7 @@ class ParticleFx;
 class Interactive;
 class VersionInfo;
 class GlobalFx;
+class MemoryReport;
 
 class World final {
   public:
@@ -108,6 +109,7 @@ class World final {
 
     void                 updateAnimation(uint64_t dt);
     void                 resetPositionToTA();
+    void                 memoryUsage(MemoryReport& rep) const;
 
     auto                 takeHero() -> std::unique_ptr<Npc>;
     Npc*                 player() const { return npcPlayer; }
@@ -10,6 +10,7 @@
 #include "world.h"
 #include "utils/workers.h"
 #include "utils/dbgpainter.h"
+#include "utils/frameprofiler.h"
 
 #include <Tempest/Painter>
 #include <Tempest/Application>
@@ -77,6 +78,7 @@ void WorldObjects::load(Serialize &fin) {
   for(size_t i=0; i<npcArr.size(); ++i) {
     npcArr[i]->load(fin,i);
     }
+  invalidateNpcIndex();
 
   fin.setEntry("worlds/",fin.worldName(),"/items");
   fin.read(sz);
@@ -85,9 +87,11 @@ void WorldObjects::load(Serialize &fin) {
     itemArr.emplace_back(std::move(it));
     items.add(itemArr.back().get());
     }
+  invalidateItmIndex();
 
   for(auto& i:rootVobs)
     i->loadVobTree(fin);
+  invalidateMobsiIndex();
 
   fin.setEntry("worlds/",fin.worldName(),"/triggerEvents");
   fin.read(sz);
@@ -137,6 +141,7 @@ void WorldObjects::save(Serialize &fout) {
   }
 
 void WorldObjects::tick(uint64_t dt, uint64_t dtPlayer) {
+  FrameProfiler::Zone zone("WorldObjects::tick");
   auto passive=std::move(sndPerc);
   sndPerc.clear();
 
@@ -154,14 +159,18 @@ void WorldObjects::tick(uint64_t dt, uint64_t dtPlayer) {
     std::sort(npcArr.begin(),npcArr.end(),[](std::unique_ptr<Npc>& a, std::unique_ptr<Npc>& b){
       return a->handle()->id<b->handle()->id;
       });
+    invalidateNpcIndex();
     }
 
+  {
+  FrameProfiler::Zone zoneNpc("WorldObjects::tickNpc");
   for(size_t i=0; i<npcArr.size(); ++i) {
     auto& npc = *npcArr[i];
     if(npc.isPlayer())
       npc.tick(dtPlayer); else
       npc.tick(dt);
     }
+  }
 
   for(auto& i:routines) {
     auto s = i.stateByTime(owner.time());
@@ -219,6 +228,7 @@ void WorldObjects::tick(uint64_t dt, uint64_t dtPlayer) {
     z->tick(dt);
   tickTriggers(dt);
 
+  FrameProfiler::Zone zonePerc("WorldObjects::perception");
   for(auto& ptr:npcNear) {
     Npc& i = *ptr;
     if(i.isPlayer() || i.isDead())
@@ -254,27 +264,128 @@ void WorldObjects::tick(uint64_t dt, uint64_t dtPlayer) {
 uint32_t WorldObjects::npcId(const Npc *ptr) const {
   if(ptr==nullptr)
     return uint32_t(-1);
-  for(size_t i=0;i<npcArr.size();++i)
-    if(npcArr[i].get()==ptr)
-      return uint32_t(i);
+  buildNpcIndex();
+  auto i = npcIndex.find(ptr);
+  if(i!=npcIndex.end())
+    return i->second;
   return uint32_t(-1);
   }
 
 uint32_t WorldObjects::itmId(const void *ptr) const {
-  for(size_t i=0;i<itemArr.size();++i)
-    if(&itemArr[i]->handle()==ptr)
-      return uint32_t(i);
+  if(ptr==nullptr)
+    return uint32_t(-1);
+  buildItmIndex();
+  auto i = itmIndex.find(ptr);
+  if(i!=itmIndex.end())
+    return i->second;
   return uint32_t(-1);
   }
 
 uint32_t WorldObjects::mobsiId(const void* ptr) const {
-  uint32_t ret=0;
+  if(ptr==nullptr)
+    return uint32_t(-1);
+  buildMobsiIndex();
+  auto i = mobsiIndex.find(ptr);
+  if(i!=mobsiIndex.end())
+    return i->second;
+  return uint32_t(-1);
+  }
+
+void WorldObjects::buildNpcIndex() const {
+  if(npcIndexValid)
+    return;
+  npcIndex.clear();
+  npcByInstance.clear();
+  npcIndex.reserve(npcArr.size());
+  for(size_t i=0; i<npcArr.size(); ++i) {
+    auto* npc = npcArr[i].get();
+    npcIndex[npc] = uint32_t(i);
+    // first npc in array order wins, same as linear search
+    npcByInstance.emplace(npc->handle()->instanceSymbol,npc);
+    }
+  npcIndexValid = true;
+  }
+
+void WorldObjects::buildItmIndex() const {
+  if(itmIndexValid)
+    return;
+  itmIndex.clear();
+  itmIndex.reserve(itemArr.size());
+  for(size_t i=0; i<itemArr.size(); ++i)
+    itmIndex[&itemArr[i]->handle()] = uint32_t(i);
+  itmIndexValid = true;
+  }
+
+void WorldObjects::buildMobsiIndex() const {
+  if(mobsiIndexValid)
+    return;
+  mobsiIndex.clear();
+  mobsiByTag.clear();
+  mobsiIndex.reserve(interactiveObj.size());
+  uint32_t id = 0;
   for(auto& i:interactiveObj) {
-    if(i==ptr)
-      return ret;
-    ++ret;
+    mobsiIndex[i] = id;
+    mobsiByTag.emplace(i->tag(),i);
+    ++id;
     }
-  return uint32_t(-1);
+  mobsiIndexValid = true;
+  }
+
+// new objects are appended to the end of container: index stays valid
+void WorldObjects::appendNpcIndex(Npc& npc) {
+  if(!npcIndexValid)
+    return;
+  npcIndex[&npc] = uint32_t(npcArr.size()-1);
+  npcByInstance.emplace(npc.handle()->instanceSymbol,&npc);
+  }
+
+void WorldObjects::appendItmIndex(Item& itm) {
+  if(!itmIndexValid)
+    return;
+  itmIndex[&itm.handle()] = uint32_t(itemArr.size()-1);
+  }
+
+void WorldObjects::appendMobsiIndex(Interactive& obj) {
+  if(!mobsiIndexValid)
+    return;
+  mobsiIndex[&obj] = uint32_t(interactiveObj.size()-1);
+  mobsiByTag.emplace(obj.tag(),&obj);
+  }
+
+// npc was removed from slot 'id' by swap-and-pop: drop it and re-point former last npc
+void WorldObjects::eraseNpcIndex(Npc& npc, uint32_t id) {
+  if(!npcIndexValid)
+    return;
+  npcIndex.erase(&npc);
+  Npc* moved = id<npcArr.size() ? npcArr[id].get() : nullptr;
+  if(moved!=nullptr)
+    npcIndex[moved] = id;
+
+  const size_t inst = npc.handle()->instanceSymbol;
+  auto it = npcByInstance.find(inst);
+  if(it!=npcByInstance.end() && it->second==&npc) {
+    npcByInstance.erase(it);
+    for(auto& i:npcArr)
+      if(i->handle()->instanceSymbol==inst) {
+        npcByInstance.emplace(inst,i.get());
+        break;
+        }
+    }
+
+  if(moved!=nullptr) {
+    // moved npc may now come first in array order
+    auto m = npcByInstance.find(moved->handle()->instanceSymbol);
+    if(m!=npcByInstance.end() && npcIndex[m->second]>id)
+      m->second = moved;
+    }
+  }
+
+void WorldObjects::eraseItmIndex(const Item& itm, uint32_t id) {
+  if(!itmIndexValid)
+    return;
+  itmIndex.erase(&itm.handle());
+  if(id<itemArr.size())
+    itmIndex[&itemArr[id]->handle()] = id;
   }
 
 Npc* WorldObjects::addNpc(size_t npcInstance, std::string_view at) {
@@ -307,6 +418,7 @@ Npc* WorldObjects::addNpc(size_t npcInstance, std::string_view at) {
     npc->attachToPoint(pos);
     npc->updateTransform();
     npcArr.emplace_back(npc);
+    appendNpcIndex(*npc);
     } else {
     auto& point = owner.deadPoint();
     npc->attachToPoint(nullptr);
@@ -325,6 +437,7 @@ Npc* WorldObjects::addNpc(size_t npcInstance, const Vec3& pos) {
   npc->updateTransform();
 
   npcArr.emplace_back(npc);
+  appendNpcIndex(*npc);
   return npc;
   }
 
@@ -347,20 +460,19 @@ Npc* WorldObjects::insertPlayer(std::unique_ptr<Npc> &&npc, std::string_view at)
     npc->updateTransform();
     }
   npcArr.emplace_back(std::move(npc));
+  appendNpcIndex(*npcArr.back());
   return npcArr.back().get();
   }
 
 std::unique_ptr<Npc> WorldObjects::takeNpc(const Npc* ptr) {
-  for(size_t i=0; i<npcArr.size(); ++i){
-    auto& npc=*npcArr[i];
-    if(&npc==ptr){
-      auto ret=std::move(npcArr[i]);
-      npcArr[i] = std::move(npcArr.back());
-      npcArr.pop_back();
-      return ret;
-      }
-    }
-  return nullptr;
+  const uint32_t i = npcId(ptr);
+  if(i==uint32_t(-1))
+    return nullptr;
+  auto ret=std::move(npcArr[i]);
+  npcArr[i] = std::move(npcArr.back());
+  npcArr.pop_back();
+  eraseNpcIndex(*ret,i);
+  return ret;
   }
 
 void WorldObjects::tickNear(uint64_t /*dt*/) {
@@ -373,6 +485,7 @@ void WorldObjects::tickNear(uint64_t /*dt*/) {
   }
 
 void WorldObjects::tickTriggers(uint64_t /*dt*/) {
+  FrameProfiler::Zone zone("WorldObjects::tickTriggers");
   auto evt = std::move(triggerEvents);
   triggerEvents.clear();
 
@@ -402,15 +515,55 @@ void WorldObjects::execTriggerEvent(const TriggerEvent& e) {
     Log::d("unable to process trigger: \"",e.target,"\"");
   }
 
+// pose update period in frames: full rate near the player, reduced with distance and when out of view
+static uint32_t animLodRate(const Vec3& pos, const Vec3& viewer, bool visible) {
+  static const float nearRange = 1500.f;
+  static const float midRange  = 4000.f;
+
+  const float dist = (pos-viewer).quadLength();
+  if(!visible)
+    return dist<nearRange*nearRange ? 2 : 8;
+  if(dist<nearRange*nearRange)
+    return 1;
+  if(dist<midRange*midRange)
+    return 2;
+  return 4;
+  }
+
+static bool animLodVisible(const Vec3& pos, const Frustrum& fr) {
+  return fr.testPoint(pos,200.f);
+  }
+
+// spread reduced-rate updates of different objects over frames
+static bool animLodSkip(uint32_t rate, uint32_t frame, const void* obj) {
+  if(rate<=1)
+    return false;
+  return (frame + uint32_t(reinterpret_cast<uintptr_t>(obj)>>4))%rate!=0;
+  }
+
 void WorldObjects::updateAnimation(uint64_t dt) {
   static bool doAnim=true;
   if(!doAnim)
     return;
-  Workers::parallelFor(npcArr,[dt](std::unique_ptr<Npc>& i){
-    i->updateAnimation(dt);
+
+  // NOTE: animation events are processed in Npc::tick and stay exact, only pose evaluation is throttled
+  const Npc*      pl     = owner.player();
+  const Vec3      viewer = pl!=nullptr ? pl->position() : Vec3();
+  const Frustrum& fr     = owner.view()->mainFrustrum();
+  const uint32_t  frame  = animFrame++;
+
+  Workers::parallelFor(npcArr,[dt,pl,viewer,&fr,frame](std::unique_ptr<Npc>& i){
+    if(i.get()==pl) {
+      i->updateAnimation(dt);
+      return;
+      }
+    const bool     visible = animLodVisible(i->position(),fr);
+    const uint32_t rate    = animLodRate(i->position(),viewer,visible);
+    i->updateAnimation(dt,animLodSkip(rate,frame,i.get()),visible);
     });
-  interactiveObj.parallelFor([dt](Interactive& i){
-    i.updateAnimation(dt);
+  interactiveObj.parallelFor([dt,viewer,&fr,frame](Interactive& i){
+    const uint32_t rate = animLodRate(i.position(),viewer,animLodVisible(i.position(),fr));
+    i.updateAnimation(dt,animLodSkip(rate,frame,&i));
     });
   }
 
@@ -442,9 +595,10 @@ Npc *WorldObjects::findHero() {
   }
 
 Npc *WorldObjects::findNpcByInstance(size_t instance) {
-  for(auto& i:npcArr)
-    if(i->handle()->instanceSymbol==instance)
-      return i.get();
+  buildNpcIndex();
+  auto i = npcByInstance.find(instance);
+  if(i!=npcByInstance.end())
+    return i->second;
   return nullptr;
   }
 
@@ -540,17 +694,18 @@ Item* WorldObjects::addItem(const ZenLoad::zCVobData &vob) {
   }
 
 std::unique_ptr<Item> WorldObjects::takeItem(Item &it) {
-  for(auto& i:itemArr)
-    if(i.get()==&it){
-      auto ret=std::move(i);
-      i = std::move(itemArr.back());
-      itemArr.pop_back();
-      items.del(ret.get());
-      ret->setPhysicsDisable();
-      onItemRemoved(*ret);
-      return ret;
-      }
-  return nullptr;
+  const uint32_t id = itmId(&it.handle());
+  if(id==uint32_t(-1))
+    return nullptr;
+  auto& i   = itemArr[id];
+  auto  ret = std::move(i);
+  i = std::move(itemArr.back());
+  itemArr.pop_back();
+  eraseItmIndex(*ret,id);
+  items.del(ret.get());
+  ret->setPhysicsDisable();
+  onItemRemoved(*ret);
+  return ret;
   }
 
 void WorldObjects::removeItem(Item &it) {
@@ -560,10 +715,10 @@ void WorldObjects::removeItem(Item &it) {
   }
 
 size_t WorldObjects::hasItems(std::string_view tag, size_t itemCls) {
-  for(auto& i:interactiveObj)
-    if(i->tag()==tag) {
-      return i->inventory().itemCount(itemCls);
-      }
+  buildMobsiIndex();
+  auto i = mobsiByTag.find(tag);
+  if(i!=mobsiByTag.end())
+    return i->second->inventory().itemCount(itemCls);
   return 0;
   }
 
@@ -611,6 +766,7 @@ Item* WorldObjects::addItem(size_t itemInstance, const Tempest::Vec3& pos, const
   auto* it=ptr.get();
   itemArr.emplace_back(std::move(ptr));
   items.add(itemArr.back().get());
+  appendItmIndex(*it);
 
   it->setPosition (pos.x, pos.y, pos.z);
   it->setDirection(dir.x, dir.y, dir.z);
@@ -634,6 +790,7 @@ Item* WorldObjects::addItemDyn(size_t itemInstance, const Tempest::Matrix4x4& po
   it->handle().owner = ownerNpc==size_t(-1) ? 0 : uint32_t(ownerNpc);
   itemArr.emplace_back(std::move(ptr));
   items.add(itemArr.back().get());
+  appendItmIndex(*it);
 
   it->setObjMatrix(pos);
 
@@ -642,6 +799,7 @@ Item* WorldObjects::addItemDyn(size_t itemInstance, const Tempest::Matrix4x4& po
 
 void WorldObjects::addInteractive(Interactive* obj) {
   interactiveObj.add(obj);
+  appendMobsiIndex(*obj);
   }
 
 void WorldObjects::addStatic(StaticObj* obj) {
@@ -667,10 +825,7 @@ Interactive* WorldObjects::validateInteractive(Interactive *def) {
 Npc *WorldObjects::validateNpc(Npc *def) {
   if(def==nullptr)
     return nullptr;
-  for(auto& i:npcArr)
-    if(i.get()==def)
-      return def;
-  return nullptr;
+  return npcId(def)!=uint32_t(-1) ? def : nullptr;
   }
 
 Item *WorldObjects::validateItem(Item *def) {
@@ -835,6 +990,7 @@ void WorldObjects::resetPositionToTA() {
   for(auto& i:npcInvalid)
     npcArr.push_back(std::move(i));
   npcInvalid.clear();
+  invalidateNpcIndex();
 
   for(size_t i=0;i<npcArr.size();) {
     auto& n = *npcArr[i];
@@ -843,6 +999,7 @@ void WorldObjects::resetPositionToTA() {
       } else {
       npcInvalid.emplace_back(std::move(npcArr[i]));
       npcArr.erase(npcArr.begin()+int(i));
+      invalidateNpcIndex();
 
       auto& point = owner.deadPoint();
       auto& npc   = *npcInvalid.back();
@@ -2,6 +2,8 @@
 
 #include <vector>
 #include <memory>
+#include <unordered_map>
+#include <string_view>
 
 #include <daedalus/DaedalusGameState.h>
 
@@ -169,6 +171,17 @@ class WorldObjects final {
     std::vector<AbstractTrigger*>      triggersTk;
     std::vector<PerceptionMsg>         sndPerc;
     std::vector<TriggerEvent>          triggerEvents;
+    uint32_t                           animFrame = 0;
+
+    // lazy pointer->id lookup tables, rebuild on first use after container changes
+    mutable std::unordered_map<const void*,uint32_t>            npcIndex;
+    mutable std::unordered_map<const void*,uint32_t>            itmIndex;
+    mutable std::unordered_map<const void*,uint32_t>            mobsiIndex;
+    mutable std::unordered_map<size_t,Npc*>                     npcByInstance;
+    mutable std::unordered_map<std::string_view,Interactive*>   mobsiByTag;
+    mutable bool                                                npcIndexValid   = false;
+    mutable bool                                                itmIndexValid   = false;
+    mutable bool                                                mobsiIndexValid = false;
 
     template<class T>
     auto findObj(T &src, const Npc &pl, const SearchOpt& opt) -> typename std::remove_reference<decltype(src[0])>::type*;
@@ -180,6 +193,18 @@ class WorldObjects final {
 
     void             setMobState(const char* scheme, int32_t st);
 
+    void             invalidateNpcIndex()   { npcIndexValid   = false; }
+    void             invalidateItmIndex()   { itmIndexValid   = false; }
+    void             invalidateMobsiIndex() { mobsiIndexValid = false; }
+    void             buildNpcIndex()   const;
+    void             buildItmIndex()   const;
+    void             buildMobsiIndex() const;
+    void             appendNpcIndex(Npc& npc);
+    void             appendItmIndex(Item& itm);
+    void             appendMobsiIndex(Interactive& obj);
+    void             eraseNpcIndex(Npc& npc, uint32_t id);
+    void             eraseItmIndex(const Item& itm, uint32_t id);
+
     void             tickNear(uint64_t dt);
     void             tickTriggers(uint64_t dt);
     static bool      isTargetedBy(Npc& npc,Npc& by);